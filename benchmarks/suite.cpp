@@ -0,0 +1,427 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+////////////////////////////////////////////////////////////
+// Benchmark suite
+//
+// Sweeps the sorters of sorters.h across the distributions of
+// distributions.h, several element types and sizes from 10 to
+// 10^8 elements, and writes the results as JSON in the format
+// of Google Benchmark, which allows to compare two runs with
+// its tools. The human-readable progress goes to stderr.
+//
+// Usage: cpp-sort-benchmarks [options]
+//   --out=FILE         write the JSON results to FILE (stdout)
+//   --filter=STRING    only run the benchmarks whose name contains
+//                      STRING, names are sorter/type/distribution/size
+//   --min-size=N       smallest size to benchmark (10)
+//   --max-size=N       biggest size to benchmark (1000000)
+//   --min-time=SECONDS minimum time spent sorting per benchmark (0.1)
+//   --max-time=SECONDS bigger sizes are skipped once a single sort
+//                      takes longer than this (2)
+//
+// Build it in release mode: the JSON context reports whether
+// the library was built with assertions enabled.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters.h>
+#include "distributions.h"
+
+////////////////////////////////////////////////////////////
+// Element types
+
+// 64-byte record sorted on its integer key
+struct record
+{
+    std::int64_t key;
+    char payload[56];
+};
+
+template<typename T>
+struct type_tag {};
+
+auto make_value(int value, type_tag<int>)
+    -> int
+{
+    return value;
+}
+
+auto make_value(int value, type_tag<double>)
+    -> double
+{
+    return value;
+}
+
+auto make_value(int value, type_tag<std::string>)
+    -> std::string
+{
+    // Fixed width so that the strings are in the same order as the
+    // integers, and too long to fit in the small string buffer
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "key-%016lld",
+                  static_cast<long long>(value) + (1LL << 32));
+    return buffer;
+}
+
+auto make_value(int value, type_tag<record>)
+    -> record
+{
+    return { value, {} };
+}
+
+auto type_name(type_tag<int>) -> const char* { return "int"; }
+auto type_name(type_tag<double>) -> const char* { return "double"; }
+auto type_name(type_tag<std::string>) -> const char* { return "string"; }
+auto type_name(type_tag<record>) -> const char* { return "record64"; }
+
+// Records are sorted through a projection, which also allows
+// the radix sorters to sort them
+template<typename Sorter, typename T>
+auto sort_values(const Sorter& sorter, std::vector<T>& values)
+    -> void
+{
+    cppsort::sort(sorter, values);
+}
+
+template<typename Sorter>
+auto sort_values(const Sorter& sorter, std::vector<record>& values)
+    -> void
+{
+    cppsort::sort(sorter, values, &record::key);
+}
+
+template<typename T>
+auto is_sorted_values(const std::vector<T>& values)
+    -> bool
+{
+    return std::is_sorted(std::begin(values), std::end(values));
+}
+
+auto is_sorted_values(const std::vector<record>& values)
+    -> bool
+{
+    return std::is_sorted(std::begin(values), std::end(values),
+                          [](const record& lhs, const record& rhs) {
+                              return lhs.key < rhs.key;
+                          });
+}
+
+template<typename Sorter, typename T>
+struct can_sort:
+    std::integral_constant<bool, cppsort::is_sorter_v<Sorter, std::vector<T>&>>
+{};
+
+template<typename Sorter>
+struct can_sort<Sorter, record>:
+    std::integral_constant<bool, cppsort::is_projection_sorter_v<
+        Sorter, std::vector<record>&, decltype(&record::key)
+    >>
+{};
+
+////////////////////////////////////////////////////////////
+// Distributions
+
+using distribution_f = void (*)(std::back_insert_iterator<std::vector<int>>, std::size_t);
+
+const std::pair<const char*, distribution_f> distributions[] = {
+    { "shuffled",               shuffled()              },
+    { "shuffled_16_values",     shuffled_16_values()    },
+    { "all_equal",              all_equal()             },
+    { "ascending",              ascending()             },
+    { "descending",             descending()            },
+    { "pipe_organ",             pipe_organ()            },
+    { "push_front",             push_front()            },
+    { "push_middle",            push_middle()           },
+    { "ascending_sawtooth",     ascending_sawtooth()    },
+    { "descending_sawtooth",    descending_sawtooth()   },
+    { "alternating",            alternating()           },
+    { "alternating_16_values",  alternating_16_values() }
+};
+
+////////////////////////////////////////////////////////////
+// Options and results
+
+struct options
+{
+    std::string filter;
+    std::size_t min_size = 10;
+    std::size_t max_size = 1'000'000;
+    double min_time = 0.1;
+    double max_time = 2.0;
+};
+
+struct result
+{
+    std::string name;
+    bool error_occurred;
+    std::size_t iterations;
+    double real_time;   // nanoseconds per sort
+    double cpu_time;    // nanoseconds per sort
+    double items_per_second;
+};
+
+auto write_json(std::ostream& out, const std::vector<result>& results)
+    -> void
+{
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"cpp-sort-benchmarks\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n"
+        << "  \"benchmarks\": [";
+
+    const char* separator = "\n";
+    for (const auto& res: results) {
+        out << separator
+            << "    {\n"
+            << "      \"name\": \"" << res.name << "\",\n"
+            << "      \"run_name\": \"" << res.name << "\",\n"
+            << "      \"run_type\": \"iteration\",\n";
+        if (res.error_occurred) {
+            out << "      \"error_occurred\": true,\n"
+                << "      \"error_message\": \"the collection is not sorted\",\n";
+        }
+        out
+            << "      \"iterations\": " << res.iterations << ",\n"
+            << "      \"real_time\": " << res.real_time << ",\n"
+            << "      \"cpu_time\": " << res.cpu_time << ",\n"
+            << "      \"time_unit\": \"ns\",\n"
+            << "      \"items_per_second\": " << res.items_per_second << "\n"
+            << "    }";
+        separator = ",\n";
+    }
+    out << "\n  ]\n}\n";
+}
+
+////////////////////////////////////////////////////////////
+// Timing
+
+using clock_type = std::chrono::steady_clock;
+
+// Sorts copies of input until min_time is spent sorting; small
+// collections are sorted in batches so that the resolution of
+// the clock doesn't matter
+template<typename Sorter, typename T>
+auto measure(const Sorter& sorter, const std::vector<T>& input, double min_time,
+             result& res)
+    -> bool
+{
+    std::size_t batch_size = std::max<std::size_t>(1, 65536 / input.size());
+    std::vector<std::vector<T>> batch(batch_size);
+
+    std::chrono::duration<double> real_time(0.0);
+    std::clock_t cpu_time = 0;
+    std::size_t iterations = 0;
+    bool sorted = true;
+    do {
+        for (auto& values: batch) {
+            values = input;
+        }
+
+        auto cpu_start = std::clock();
+        auto start = clock_type::now();
+        for (auto& values: batch) {
+            sort_values(sorter, values);
+        }
+        auto end = clock_type::now();
+        auto cpu_end = std::clock();
+
+        real_time += end - start;
+        cpu_time += cpu_end - cpu_start;
+        iterations += batch_size;
+        for (auto& values: batch) {
+            sorted = sorted && is_sorted_values(values);
+        }
+    } while (real_time.count() < min_time);
+
+    res.iterations = iterations;
+    res.real_time = real_time.count() * 1e9 / iterations;
+    res.cpu_time = double(cpu_time) / CLOCKS_PER_SEC * 1e9 / iterations;
+    res.items_per_second = input.size() / (res.real_time * 1e-9);
+    return sorted;
+}
+
+template<typename T, typename Sorter>
+auto run_type(const char* sorter_name, const Sorter& sorter, const options& opts,
+              std::vector<result>& results, std::true_type)
+    -> void
+{
+    for (const auto& distribution: distributions) {
+        for (std::size_t size = 10 ; size <= opts.max_size ; size *= 10) {
+            if (size < opts.min_size) continue;
+
+            std::string name = sorter_name;
+            name += '/';
+            name += type_name(type_tag<T>{});
+            name += '/';
+            name += distribution.first;
+            name += '/';
+            name += std::to_string(size);
+            if (name.find(opts.filter) == std::string::npos) continue;
+
+            std::vector<int> ints;
+            ints.reserve(size);
+            distribution.second(std::back_inserter(ints), size);
+            std::vector<T> input;
+            input.reserve(size);
+            for (int value: ints) {
+                input.push_back(make_value(value, type_tag<T>{}));
+            }
+
+            result res;
+            res.name = name;
+            res.error_occurred = not measure(sorter, input, opts.min_time, res);
+            results.push_back(res);
+            if (res.error_occurred) {
+                // Reported like Google Benchmark reports errors
+                std::cerr << name << ": the collection is not sorted\n";
+                continue;
+            }
+            std::cerr << name << ' ' << res.real_time << " ns (" << res.iterations << " iterations)\n";
+
+            // Quadratic algorithms quickly become too slow
+            if (res.real_time * 1e-9 > opts.max_time) break;
+        }
+    }
+}
+
+template<typename T, typename Sorter>
+auto run_type(const char*, const Sorter&, const options&,
+              std::vector<result>&, std::false_type)
+    -> void
+{}
+
+template<typename Sorter>
+auto run_sorter(const char* sorter_name, const Sorter& sorter, const options& opts,
+                std::vector<result>& results)
+    -> void
+{
+    run_type<int>(sorter_name, sorter, opts, results, can_sort<Sorter, int>{});
+    run_type<double>(sorter_name, sorter, opts, results, can_sort<Sorter, double>{});
+    run_type<std::string>(sorter_name, sorter, opts, results, can_sort<Sorter, std::string>{});
+    run_type<record>(sorter_name, sorter, opts, results, can_sort<Sorter, record>{});
+}
+
+////////////////////////////////////////////////////////////
+// Main
+
+auto parse_options(int argc, char* argv[])
+    -> options
+{
+    options opts;
+    for (int i = 1 ; i < argc ; ++i) {
+        std::string arg = argv[i];
+        auto value = arg.substr(arg.find('=') + 1);
+        if (arg.compare(0, 6, "--out=") == 0) {
+            // Handled in main
+        } else if (arg.compare(0, 9, "--filter=") == 0) {
+            opts.filter = value;
+        } else if (arg.compare(0, 11, "--min-size=") == 0) {
+            opts.min_size = std::stoull(value);
+        } else if (arg.compare(0, 11, "--max-size=") == 0) {
+            opts.max_size = std::stoull(value);
+        } else if (arg.compare(0, 11, "--min-time=") == 0) {
+            opts.min_time = std::stod(value);
+        } else if (arg.compare(0, 11, "--max-time=") == 0) {
+            opts.max_time = std::stod(value);
+        } else {
+            std::cerr << "unknown option: " << arg << '\n';
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return opts;
+}
+
+int main(int argc, char* argv[])
+{
+    auto opts = parse_options(argc, argv);
+
+    std::vector<result> results;
+    run_sorter("adaptive_sorter", cppsort::adaptive_sorter{}, opts, results);
+    run_sorter("block_sorter", cppsort::block_sorter<>{}, opts, results);
+    run_sorter("counting_sorter", cppsort::counting_sorter{}, opts, results);
+    run_sorter("default_sorter", cppsort::default_sorter{}, opts, results);
+    run_sorter("drop_merge_sorter", cppsort::drop_merge_sorter{}, opts, results);
+    run_sorter("float_spread_sorter", cppsort::float_spread_sorter{}, opts, results);
+    run_sorter("grail_sorter", cppsort::grail_sorter<>{}, opts, results);
+    run_sorter("heap_sorter", cppsort::heap_sorter{}, opts, results);
+    run_sorter("insertion_sorter", cppsort::insertion_sorter{}, opts, results);
+    run_sorter("integer_spread_sorter", cppsort::integer_spread_sorter{}, opts, results);
+    run_sorter("merge_insertion_sorter", cppsort::merge_insertion_sorter{}, opts, results);
+    run_sorter("merge_sorter", cppsort::merge_sorter{}, opts, results);
+    run_sorter("parallel_counting_sorter", cppsort::parallel_counting_sorter{}, opts, results);
+    run_sorter("parallel_merge_sorter", cppsort::parallel_merge_sorter{}, opts, results);
+    run_sorter("parallel_pdq_sorter", cppsort::parallel_pdq_sorter{}, opts, results);
+    run_sorter("parallel_ska_sorter", cppsort::parallel_ska_sorter{}, opts, results);
+    run_sorter("parallel_string_spread_sorter", cppsort::parallel_string_spread_sorter{}, opts, results);
+    run_sorter("pdq_sorter", cppsort::pdq_sorter{}, opts, results);
+    run_sorter("poplar_sorter", cppsort::poplar_sorter{}, opts, results);
+    run_sorter("quick_sorter", cppsort::quick_sorter{}, opts, results);
+    run_sorter("selection_sorter", cppsort::selection_sorter{}, opts, results);
+    run_sorter("ska_sorter", cppsort::ska_sorter{}, opts, results);
+    run_sorter("smooth_sorter", cppsort::smooth_sorter{}, opts, results);
+    run_sorter("spread_sorter", cppsort::spread_sorter{}, opts, results);
+    run_sorter("std_sorter", cppsort::std_sorter{}, opts, results);
+    run_sorter("string_prefix_sorter", cppsort::string_prefix_sorter{}, opts, results);
+    run_sorter("string_spread_sorter", cppsort::string_spread_sorter{}, opts, results);
+    run_sorter("tim_sorter", cppsort::tim_sorter{}, opts, results);
+    run_sorter("verge_sorter", cppsort::verge_sorter{}, opts, results);
+
+    for (int i = 1 ; i < argc ; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 6, "--out=") == 0) {
+            std::ofstream out(arg.substr(6));
+            write_json(out, results);
+            return 0;
+        }
+    }
+    write_json(std::cout, results);
+}
@@ -27,15 +27,18 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
-#include <cpp-sort/utility/iter_move.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/checkers.h"
 #include "../detail/indirect_compare.h"
 
@@ -62,63 +65,51 @@ namespace cppsort
                             Compare compare={}, Projection projection={}) const
                 -> void
             {
-                using utility::iter_move;
+                // Use the smallest indices that can represent every
+                // position in the collection
+                auto size = std::distance(first, last);
+                if (std::uintmax_t(size) <= std::numeric_limits<std::uint32_t>::max()) {
+                    sort_indirectly<std::uint32_t>(std::move(first), std::move(last),
+                                                   std::move(compare), std::move(projection));
+                } else {
+                    sort_indirectly<std::size_t>(std::move(first), std::move(last),
+                                                 std::move(compare), std::move(projection));
+                }
+            }
 
+            template<
+                typename Index,
+                typename RandomAccessIterator,
+                typename Compare,
+                typename Projection
+            >
+            static auto sort_indirectly(RandomAccessIterator first, RandomAccessIterator last,
+                                        Compare compare, Projection projection)
+                -> void
+            {
                 ////////////////////////////////////////////////////////////
-                // Indirectly sort the iterators
+                // Indirectly sort the indices of the elements
 
-                // Copy the iterators in a vector
-                std::vector<RandomAccessIterator> iterators;
-                iterators.reserve(std::distance(first, last));
-                for (RandomAccessIterator it = first ; it != last ; ++it)
+                auto size = static_cast<Index>(std::distance(first, last));
+                std::vector<Index> indices;
+                indices.reserve(size);
+                for (Index i = 0 ; i < size ; ++i)
                 {
-                    iterators.push_back(it);
+                    indices.push_back(i);
                 }
 
-                // Sort the iterators on pointed values
-                Sorter{}(std::begin(iterators), std::end(iterators),
-                         detail::indirect_compare<Compare, Projection>(compare, projection));
+                // Sort the indices on pointed values
+                Sorter{}(std::begin(indices), std::end(indices),
+                         detail::indexed_compare<RandomAccessIterator, Compare, Projection>(
+                             first, std::move(compare), std::move(projection)
+                         ));
 
                 ////////////////////////////////////////////////////////////
-                // Move the values according the iterator's positions
+                // Move the values according the indices' positions
 
-                if (first == last) return;
-
-                std::vector<bool> sorted(std::distance(first, last), false);
-
-                // Element where the current cycle starts
-                RandomAccessIterator start = first;
-
-                while (start != last)
-                {
-                    // Find the element to put in current's place
-                    RandomAccessIterator current = start;
-                    auto next_pos = std::distance(first, current);
-                    RandomAccessIterator next = iterators[next_pos];
-                    sorted[next_pos] = true;
-
-                    // Process the current cycle
-                    if (next != current)
-                    {
-                        auto tmp = iter_move(current);
-                        while (next != start)
-                        {
-                            *current = iter_move(next);
-                            current = next;
-                            auto next_pos = std::distance(first, next);
-                            next = iterators[next_pos];
-                            sorted[next_pos] = true;
-                        }
-                        *current = std::move(tmp);
-                    }
-
-                    // Find the next cycle
-                    do
-                    {
-                        ++start;
-                    }
-                    while (start != last && sorted[start - first]);
-                }
+                // Already placed elements are marked in the indices
+                // themselves, no additional memory is needed
+                apply_permutation_in_band(first, last, std::begin(indices));
             }
 
             ////////////////////////////////////////////////////////////
@@ -0,0 +1,712 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_ADAPTERS_INSTRUMENTED_ADAPTER_H_
+#define CPPSORT_ADAPTERS_INSTRUMENTED_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "../detail/checkers.h"
+#include "../detail/detection.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/logical_traits.h"
+#include "../detail/memory.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Statistics
+    //
+    // Accumulated by every instrumented_adapter given the same
+    // object; the counters are atomic so that several sorts can
+    // publish their results concurrently and another thread can
+    // read them while sorts are running. A sort that exits with
+    // an exception still publishes everything it counted
+
+    struct sort_statistics
+    {
+        std::atomic<std::uint64_t> sorts{0};
+        std::atomic<std::uint64_t> elements{0};
+        std::atomic<std::uint64_t> comparisons{0};
+        std::atomic<std::uint64_t> projections{0};
+        std::atomic<std::uint64_t> moves{0};
+        std::atomic<std::uint64_t> swaps{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes_allocated{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+
+        auto reset() noexcept
+            -> void
+        {
+            sorts = 0;
+            elements = 0;
+            comparisons = 0;
+            projections = 0;
+            moves = 0;
+            swaps = 0;
+            allocations = 0;
+            bytes_allocated = 0;
+            nanoseconds = 0;
+        }
+    };
+
+    namespace detail
+    {
+        inline auto increment(std::atomic<std::uint64_t>& counter,
+                              std::uint64_t value=1) noexcept
+            -> void
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Counters of a single sort
+        //
+        // Every thread taking part in a sort increments its own
+        // block of plain counters, and the blocks are added to the
+        // shared statistics once the sort is over: incrementing an
+        // atomic counter for every operation is slow enough to skew
+        // the measured times
+
+        struct local_counters
+        {
+            std::uint64_t comparisons = 0;
+            std::uint64_t projections = 0;
+            std::uint64_t moves = 0;
+            std::uint64_t swaps = 0;
+        };
+
+        class sort_counters
+        {
+            public:
+
+                sort_counters():
+                    _id(next_id())
+                {}
+
+                sort_counters(const sort_counters&) = delete;
+                sort_counters& operator=(const sort_counters&) = delete;
+
+                auto local()
+                    -> local_counters&
+                {
+                    // Cache the block of the current thread, the lock is
+                    // only taken the first time a thread increments one
+                    // of the counters of a given sort
+                    thread_local std::uint64_t cached_id = 0;
+                    thread_local local_counters* cached_counters = nullptr;
+                    if (cached_id != _id) {
+                        cached_counters = &find_local();
+                        cached_id = _id;
+                    }
+                    return *cached_counters;
+                }
+
+                auto publish(sort_statistics& stats)
+                    -> void
+                {
+                    local_counters total;
+                    for (auto& block: _blocks) {
+                        total.comparisons += block.counters.comparisons;
+                        total.projections += block.counters.projections;
+                        total.moves += block.counters.moves;
+                        total.swaps += block.counters.swaps;
+                    }
+                    increment(stats.comparisons, total.comparisons);
+                    increment(stats.projections, total.projections);
+                    increment(stats.moves, total.moves);
+                    increment(stats.swaps, total.swaps);
+                }
+
+            private:
+
+                struct thread_block
+                {
+                    std::thread::id thread;
+                    local_counters counters;
+                };
+
+                static auto next_id()
+                    -> std::uint64_t
+                {
+                    // Zero is never used so that it can't match the
+                    // cached identifier of a thread that never counted
+                    static std::atomic<std::uint64_t> id{0};
+                    return id.fetch_add(1, std::memory_order_relaxed) + 1;
+                }
+
+                auto find_local()
+                    -> local_counters&
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    auto thread = std::this_thread::get_id();
+                    for (auto& block: _blocks) {
+                        if (block.thread == thread) {
+                            return block.counters;
+                        }
+                    }
+                    _blocks.push_front(thread_block{thread, {}});
+                    return _blocks.front().counters;
+                }
+
+                std::uint64_t _id;
+                std::mutex _mutex;
+                std::forward_list<thread_block> _blocks;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Function object counting its calls, used for both the
+        // comparison and the projection
+
+        template<typename Function>
+        class call_counter
+        {
+            public:
+
+                call_counter(Function function, sort_counters& counters,
+                             std::uint64_t local_counters::* count):
+                    function(std::move(function)),
+                    counters(&counters),
+                    count(count)
+                {}
+
+                // SFINAE-friendly so that sorters can still tell
+                // comparisons and projections apart
+                template<typename... Args>
+                auto operator()(Args&&... args)
+                    -> decltype(utility::as_function(std::declval<Function&>())(
+                        std::forward<Args>(args)...
+                    ))
+                {
+                    ++(counters->local().*count);
+                    auto&& func = utility::as_function(function);
+                    return func(std::forward<Args>(args)...);
+                }
+
+                // Accessible member data
+                Function function;
+
+            private:
+
+                sort_counters* counters;
+                std::uint64_t local_counters::* count;
+        };
+
+        // Radix sorters only accept the standard comparisons, which
+        // they don't call: those are passed unwrapped when the
+        // adapted sorter doesn't accept a call_counter
+
+        template<typename Compare>
+        using is_radix_compare = std::integral_constant<bool,
+            std::is_same<Compare, std::less<>>::value ||
+            std::is_same<Compare, std::greater<>>::value
+        >;
+
+        template<typename Function>
+        auto count_calls(Function function, sort_counters& counters,
+                         std::uint64_t local_counters::* count, std::true_type)
+            -> call_counter<Function>
+        {
+            return call_counter<Function>(std::move(function), counters, count);
+        }
+
+        template<typename Function>
+        auto count_calls(Function function, sort_counters&,
+                         std::uint64_t local_counters::*, std::false_type)
+            -> Function
+        {
+            return function;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Memory resource counting the allocations made through it
+
+        class counting_memory_resource:
+            public utility::memory_resource
+        {
+            public:
+
+                counting_memory_resource(utility::memory_resource* upstream,
+                                         sort_statistics& stats) noexcept:
+                    _upstream(upstream),
+                    _stats(&stats)
+                {}
+
+            private:
+
+                auto do_allocate(std::size_t bytes, std::size_t alignment)
+                    -> void* override
+                {
+                    void* memory = _upstream->allocate(bytes, alignment);
+                    increment(_stats->allocations);
+                    increment(_stats->bytes_allocated, bytes);
+                    return memory;
+                }
+
+                auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                    -> void override
+                {
+                    _upstream->deallocate(pointer, bytes, alignment);
+                }
+
+                auto do_is_equal(const memory_resource& other) const noexcept
+                    -> bool override
+                {
+                    return this == &other;
+                }
+
+                utility::memory_resource* _upstream;
+                sort_statistics* _stats;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Iterator counting the moves and swaps performed through
+        // iter_move and iter_swap
+
+        template<typename Iterator>
+        class instrumented_iterator
+        {
+            public:
+
+                ////////////////////////////////////////////////////////////
+                // Public types
+
+                using iterator_category = iterator_category_t<Iterator>;
+                using iterator_type     = Iterator;
+                using value_type        = value_type_t<Iterator>;
+                using difference_type   = difference_type_t<Iterator>;
+                using pointer           = pointer_t<Iterator>;
+                using reference         = reference_t<Iterator>;
+
+                ////////////////////////////////////////////////////////////
+                // Constructors
+
+                instrumented_iterator() = default;
+
+                instrumented_iterator(Iterator it, sort_counters& counters):
+                    _it(std::move(it)),
+                    _counters(&counters)
+                {}
+
+                ////////////////////////////////////////////////////////////
+                // Members access
+
+                auto base() const
+                    -> iterator_type
+                {
+                    return _it;
+                }
+
+                auto counters() const
+                    -> sort_counters&
+                {
+                    return *_counters;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Element access
+
+                auto operator*() const
+                    -> reference
+                {
+                    return *_it;
+                }
+
+                auto operator->() const
+                    -> pointer
+                {
+                    return &(operator*());
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Increment/decrement operators
+
+                auto operator++()
+                    -> instrumented_iterator&
+                {
+                    ++_it;
+                    return *this;
+                }
+
+                auto operator++(int)
+                    -> instrumented_iterator
+                {
+                    auto tmp = *this;
+                    operator++();
+                    return tmp;
+                }
+
+                auto operator--()
+                    -> instrumented_iterator&
+                {
+                    --_it;
+                    return *this;
+                }
+
+                auto operator--(int)
+                    -> instrumented_iterator
+                {
+                    auto tmp = *this;
+                    operator--();
+                    return tmp;
+                }
+
+                auto operator+=(difference_type increment)
+                    -> instrumented_iterator&
+                {
+                    _it += increment;
+                    return *this;
+                }
+
+                auto operator-=(difference_type increment)
+                    -> instrumented_iterator&
+                {
+                    _it -= increment;
+                    return *this;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Elements access operators
+
+                auto operator[](difference_type pos) const
+                    -> reference
+                {
+                    return _it[pos];
+                }
+
+            private:
+
+                Iterator _it;
+                sort_counters* _counters = nullptr;
+        };
+
+        template<typename Iterator>
+        auto iter_swap(instrumented_iterator<Iterator> lhs, instrumented_iterator<Iterator> rhs)
+            -> void
+        {
+            ++lhs.counters().local().swaps;
+            using utility::iter_swap;
+            iter_swap(lhs.base(), rhs.base());
+        }
+
+        template<typename Iterator>
+        auto iter_move(instrumented_iterator<Iterator> it)
+            -> rvalue_reference_t<Iterator>
+        {
+            ++it.counters().local().moves;
+            using utility::iter_move;
+            return iter_move(it.base());
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Comparison operators
+
+        template<typename Iterator>
+        auto operator==(const instrumented_iterator<Iterator>& lhs,
+                        const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() == rhs.base();
+        }
+
+        template<typename Iterator>
+        auto operator!=(const instrumented_iterator<Iterator>& lhs,
+                        const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() != rhs.base();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Relational operators
+
+        template<typename Iterator>
+        auto operator<(const instrumented_iterator<Iterator>& lhs,
+                       const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() < rhs.base();
+        }
+
+        template<typename Iterator>
+        auto operator<=(const instrumented_iterator<Iterator>& lhs,
+                        const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() <= rhs.base();
+        }
+
+        template<typename Iterator>
+        auto operator>(const instrumented_iterator<Iterator>& lhs,
+                       const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() > rhs.base();
+        }
+
+        template<typename Iterator>
+        auto operator>=(const instrumented_iterator<Iterator>& lhs,
+                        const instrumented_iterator<Iterator>& rhs)
+            -> bool
+        {
+            return lhs.base() >= rhs.base();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Arithmetic operators
+
+        template<typename Iterator>
+        auto operator+(instrumented_iterator<Iterator> it,
+                       difference_type_t<instrumented_iterator<Iterator>> size)
+            -> instrumented_iterator<Iterator>
+        {
+            return it += size;
+        }
+
+        template<typename Iterator>
+        auto operator+(difference_type_t<instrumented_iterator<Iterator>> size,
+                       instrumented_iterator<Iterator> it)
+            -> instrumented_iterator<Iterator>
+        {
+            return it += size;
+        }
+
+        template<typename Iterator>
+        auto operator-(instrumented_iterator<Iterator> it,
+                       difference_type_t<instrumented_iterator<Iterator>> size)
+            -> instrumented_iterator<Iterator>
+        {
+            return it -= size;
+        }
+
+        template<typename Iterator>
+        auto operator-(const instrumented_iterator<Iterator>& lhs,
+                       const instrumented_iterator<Iterator>& rhs)
+            -> difference_type_t<instrumented_iterator<Iterator>>
+        {
+            return lhs.base() - rhs.base();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Whether the adapted sorter accepts the comparison wrapped
+        // in a call_counter, or unwrapped when it isn't
+        //
+        // The iterator is checked first so that instrumented_iterator
+        // is never instantiated with a type that isn't an iterator
+
+        template<typename Sorter, typename Iterator, typename Compare, typename... Projection>
+        struct counts_comparisons;
+
+        template<typename Sorter, typename Iterator, typename Compare>
+        struct counts_comparisons<Sorter, Iterator, Compare>:
+            conjunction<
+                is_detected<iterator_category_t, Iterator>,
+                is_comparison_sorter_iterator<
+                    Sorter, instrumented_iterator<Iterator>, call_counter<Compare>
+                >
+            >
+        {};
+
+        template<typename Sorter, typename Iterator, typename Compare, typename Projection>
+        struct counts_comparisons<Sorter, Iterator, Compare, Projection>:
+            conjunction<
+                is_detected<iterator_category_t, Iterator>,
+                is_comparison_projection_sorter_iterator<
+                    Sorter, instrumented_iterator<Iterator>,
+                    call_counter<Compare>, call_counter<Projection>
+                >
+            >
+        {};
+
+        template<typename Sorter, typename Iterator, typename Compare, typename... Projection>
+        struct passes_compare_through;
+
+        template<typename Sorter, typename Iterator, typename Compare>
+        struct passes_compare_through<Sorter, Iterator, Compare>:
+            conjunction<
+                is_radix_compare<Compare>,
+                is_detected<iterator_category_t, Iterator>,
+                is_comparison_sorter_iterator<
+                    Sorter, instrumented_iterator<Iterator>, Compare
+                >
+            >
+        {};
+
+        template<typename Sorter, typename Iterator, typename Compare, typename Projection>
+        struct passes_compare_through<Sorter, Iterator, Compare, Projection>:
+            conjunction<
+                is_radix_compare<Compare>,
+                is_detected<iterator_category_t, Iterator>,
+                is_comparison_projection_sorter_iterator<
+                    Sorter, instrumented_iterator<Iterator>,
+                    Compare, call_counter<Projection>
+                >
+            >
+        {};
+
+        ////////////////////////////////////////////////////////////
+        // Adapter
+
+        template<typename ComparisonSorter>
+        struct instrumented_adapter_impl:
+            check_iterator_category<ComparisonSorter>,
+            check_is_always_stable<ComparisonSorter>
+        {
+            explicit instrumented_adapter_impl(sort_statistics& stats,
+                                               utility::memory_resource* upstream=nullptr):
+                _stats(&stats),
+                _upstream(upstream ? upstream : utility::new_delete_resource())
+            {}
+
+            template<
+                typename Iterator,
+                typename Compare = std::less<>,
+                typename = std::enable_if_t<
+                    not is_projection_iterator_v<Compare, Iterator> && (
+                        counts_comparisons<ComparisonSorter, Iterator, Compare>::value ||
+                        passes_compare_through<ComparisonSorter, Iterator, Compare>::value
+                    )
+                >
+            >
+            auto operator()(Iterator first, Iterator last, Compare compare={}) const
+                -> void
+            {
+                instrumented_sort(
+                    std::move(first), std::move(last),
+                    [&](auto first, auto last, auto& resource, auto& counters) {
+                        make_sorter_with_resource<ComparisonSorter>(&resource)(
+                            first, last,
+                            count_calls(std::move(compare), counters, &local_counters::comparisons,
+                                        counts_comparisons<ComparisonSorter, Iterator, Compare>{})
+                        );
+                    }
+                );
+            }
+
+            template<
+                typename Iterator,
+                typename Compare,
+                typename Projection,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, Iterator, Compare> && (
+                        counts_comparisons<ComparisonSorter, Iterator, Compare, Projection>::value ||
+                        passes_compare_through<ComparisonSorter, Iterator, Compare, Projection>::value
+                    )
+                >
+            >
+            auto operator()(Iterator first, Iterator last,
+                            Compare compare, Projection projection) const
+                -> void
+            {
+                instrumented_sort(
+                    std::move(first), std::move(last),
+                    [&](auto first, auto last, auto& resource, auto& counters) {
+                        make_sorter_with_resource<ComparisonSorter>(&resource)(
+                            first, last,
+                            count_calls(std::move(compare), counters, &local_counters::comparisons,
+                                        counts_comparisons<ComparisonSorter, Iterator,
+                                                           Compare, Projection>{}),
+                            call_counter<Projection>(std::move(projection), counters,
+                                                     &local_counters::projections)
+                        );
+                    }
+                );
+            }
+
+            auto stats() const
+                -> sort_statistics&
+            {
+                return *_stats;
+            }
+
+        private:
+
+            template<typename Iterator, typename Sort>
+            auto instrumented_sort(Iterator first, Iterator last, Sort sort) const
+                -> void
+            {
+                increment(_stats->sorts);
+                increment(_stats->elements, std::distance(first, last));
+
+                counting_memory_resource resource(_upstream, *_stats);
+                sort_counters counters;
+                auto start = std::chrono::steady_clock::now();
+                auto publish = [&] {
+                    auto end = std::chrono::steady_clock::now();
+                    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+                    increment(_stats->nanoseconds, duration.count());
+                    counters.publish(*_stats);
+                };
+
+                // A sort that throws is still counted along with the
+                // time spent and the operations performed until then
+                try {
+                    sort(instrumented_iterator<Iterator>(std::move(first), counters),
+                         instrumented_iterator<Iterator>(std::move(last), counters),
+                         resource, counters);
+                } catch (...) {
+                    publish();
+                    throw;
+                }
+                publish();
+            }
+
+            sort_statistics* _stats;
+            utility::memory_resource* _upstream;
+        };
+    }
+
+    template<typename ComparisonSorter>
+    struct instrumented_adapter:
+        sorter_facade<detail::instrumented_adapter_impl<ComparisonSorter>>
+    {
+        using sorter_facade<detail::instrumented_adapter_impl<ComparisonSorter>>::sorter_facade;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<instrumented_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_ADAPTERS_INSTRUMENTED_ADAPTER_H_
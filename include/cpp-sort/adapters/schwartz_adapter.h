@@ -27,8 +27,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -36,9 +38,12 @@
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/associate_iterator.h"
 #include "../detail/checkers.h"
+#include "../detail/iterator_traits.h"
 #include "../detail/memory.h"
+#include "../detail/packed_key.h"
 
 namespace cppsort
 {
@@ -50,8 +55,11 @@ namespace cppsort
         template<typename Sorter>
         struct schwartz_adapter_impl:
             check_iterator_category<Sorter>,
-            check_is_always_stable<Sorter>
+            check_is_always_stable<Sorter>,
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<typename ForwardIterator, typename Compare, typename Projection>
             auto operator()(ForwardIterator first, ForwardIterator last,
                             Compare compare, Projection projection) const
@@ -64,15 +72,25 @@ namespace cppsort
                 static_assert(not std::is_same<Sorter, stable_adapter<std_sorter>>::value,
                               "stable_adapter<std_sorter> doesn't work with schwartz_adapter");
 
+                auto size = std::distance(first, last);
+                sort_projected(std::move(first), std::move(last), size,
+                               std::move(compare), std::move(projection),
+                               iterator_category_t<ForwardIterator>{});
+            }
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto sort_projected(ForwardIterator first, ForwardIterator last,
+                                difference_type_t<ForwardIterator> size,
+                                Compare compare, Projection projection,
+                                std::forward_iterator_tag) const
+                -> void
+            {
                 auto&& proj = utility::as_function(projection);
                 using proj_t = std::decay_t<decltype(proj(*first))>;
                 using value_t = association<ForwardIterator, proj_t>;
 
                 // Collection of projected elements
-                auto size = std::distance(first, last);
-                std::unique_ptr<value_t, operator_deleter> projected(
-                    static_cast<value_t*>(::operator new(size * sizeof(value_t)))
-                );
+                auto projected = allocate_buffer<value_t>(resource(), size);
                 destruct_n<value_t> d(0);
                 std::unique_ptr<value_t, destruct_n<value_t>&> h2(projected.get(), d);
 
@@ -83,7 +101,7 @@ namespace cppsort
                 }
 
                 // Indirectly sort the original sequence
-                Sorter{}(
+                make_sorter_with_resource<Sorter>(resource())(
                     make_associate_iterator(projected.get()),
                     make_associate_iterator(projected.get() + size),
                     std::move(compare),
@@ -91,6 +109,51 @@ namespace cppsort
                 );
             }
 
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort_projected(RandomAccessIterator first, RandomAccessIterator last,
+                                difference_type_t<RandomAccessIterator> size,
+                                Compare compare, Projection projection,
+                                std::random_access_iterator_tag) const
+                -> void
+            {
+                auto&& proj = utility::as_function(projection);
+                using proj_t = std::decay_t<decltype(proj(*first))>;
+                using value_t = packed_key<proj_t, std::uint32_t>;
+
+                // Sorting the keys alone is only worth it when the
+                // elements are bigger than the keys: the final pass
+                // is bound by cache misses for big collections
+                if (sizeof(value_type_t<RandomAccessIterator>) <= sizeof(value_t) ||
+                    std::uintmax_t(size) > std::numeric_limits<std::uint32_t>::max()) {
+                    sort_projected(std::move(first), std::move(last), size,
+                                   std::move(compare), std::move(projection),
+                                   std::forward_iterator_tag{});
+                    return;
+                }
+
+                // Collection of projected keys packed with the
+                // position of the corresponding element
+                auto projected = allocate_buffer<value_t>(resource(), size);
+                destruct_n<value_t> d(0);
+                std::unique_ptr<value_t, destruct_n<value_t>&> h2(projected.get(), d);
+
+                auto ptr = projected.get();
+                for (std::uint32_t i = 0 ; i < std::uint32_t(size) ; ++d, (void) ++i, ++ptr)
+                {
+                    ::new(ptr) value_t{proj(first[i]), i};
+                }
+
+                // Sort the keys alone, then move every element of the
+                // original sequence to its final position at once
+                make_sorter_with_resource<Sorter>(resource())(
+                    projected.get(), projected.get() + size,
+                    std::move(compare),
+                    [](const auto& value) -> auto& { return value.key; }
+                );
+                apply_permutation_in_band(first, last, projected.get(),
+                                          [](auto& value) -> auto& { return value.index; });
+            }
+
             template<typename ForwardIterator, typename Compare=std::less<>>
             auto operator()(ForwardIterator first, ForwardIterator last,
                             Compare compare={}) const
@@ -100,7 +163,9 @@ namespace cppsort
             {
                 // No projection to handle, forward everything to
                 // the adapted sorter
-                Sorter{}(std::move(first), std::move(last), std::move(compare));
+                make_sorter_with_resource<Sorter>(resource())(
+                    std::move(first), std::move(last), std::move(compare)
+                );
             }
         };
     }
@@ -108,7 +173,9 @@ namespace cppsort
     template<typename Sorter>
     struct schwartz_adapter:
         sorter_facade<detail::schwartz_adapter_impl<Sorter>>
-    {};
+    {
+        using sorter_facade<detail::schwartz_adapter_impl<Sorter>>::sorter_facade;
+    };
 
     ////////////////////////////////////////////////////////////
     // is_stable specialization
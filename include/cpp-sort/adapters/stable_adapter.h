@@ -109,8 +109,11 @@ namespace cppsort
 
         template<typename Sorter>
         struct stable_adapter_impl:
-            check_iterator_category<Sorter>
+            check_iterator_category<Sorter>,
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<
                 typename Iterator,
                 typename Compare = std::less<>,
@@ -130,9 +133,7 @@ namespace cppsort
                 // Bind index to iterator
 
                 auto size = std::distance(first, last);
-                std::unique_ptr<value_t, operator_deleter> iterators(
-                    static_cast<value_t*>(::operator new(size * sizeof(value_t)))
-                );
+                auto iterators = allocate_buffer<value_t>(resource(), size);
                 destruct_n<value_t> d(0);
                 std::unique_ptr<value_t, destruct_n<value_t>&> h2(iterators.get(), d);
 
@@ -146,7 +147,7 @@ namespace cppsort
                 ////////////////////////////////////////////////////////////
                 // Sort but takes the index into account to ensure stability
 
-                return Sorter{}(
+                return make_sorter_with_resource<Sorter>(resource())(
                     make_associate_iterator(iterators.get()),
                     make_associate_iterator(iterators.get() + size),
                     make_stable_compare(std::move(compare), std::move(projection))
@@ -164,13 +165,18 @@ namespace cppsort
     template<typename Sorter>
     struct make_stable:
         sorter_facade<detail::stable_adapter_impl<Sorter>>
-    {};
+    {
+        using sorter_facade<detail::stable_adapter_impl<Sorter>>::sorter_facade;
+    };
 
     // Actual sorter
     template<typename Sorter>
     struct stable_adapter:
-        detail::check_iterator_category<Sorter>
+        detail::check_iterator_category<Sorter>,
+        detail::uses_memory_resource
     {
+        using detail::uses_memory_resource::uses_memory_resource;
+
         template<
             typename... Args,
             typename = std::enable_if_t<is_stable_v<Sorter(Args...)>>
@@ -178,7 +184,7 @@ namespace cppsort
         auto operator()(Args&&... args) const
             -> decltype(Sorter{}(std::forward<Args>(args)...))
         {
-            return Sorter{}(std::forward<Args>(args)...);
+            return detail::make_sorter_with_resource<Sorter>(resource())(std::forward<Args>(args)...);
         }
 
         template<
@@ -189,7 +195,7 @@ namespace cppsort
         auto operator()(Args&&... args) const
             -> decltype(make_stable<Sorter>{}(std::forward<Args>(args)...))
         {
-            return make_stable<Sorter>{}(std::forward<Args>(args)...);
+            return make_stable<Sorter>(resource())(std::forward<Args>(args)...);
         }
 
         ////////////////////////////////////////////////////////////
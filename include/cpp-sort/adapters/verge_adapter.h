@@ -34,6 +34,7 @@
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
+#include "../detail/memory.h"
 #include "../detail/vergesort.h"
 
 namespace cppsort
@@ -44,8 +45,11 @@ namespace cppsort
     namespace detail
     {
         template<typename FallbackSorter>
-        struct verge_adapter_impl
+        struct verge_adapter_impl:
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<
                 typename RandomAccessIterator,
                 typename Compare = std::less<>,
@@ -68,7 +72,8 @@ namespace cppsort
 
                 vergesort(std::move(first), std::move(last),
                           std::move(compare), std::move(projection),
-                          FallbackSorter{});
+                          make_sorter_with_resource<FallbackSorter>(resource()),
+                          resource());
             }
 
             ////////////////////////////////////////////////////////////
@@ -82,7 +87,9 @@ namespace cppsort
     template<typename FallbackSorter>
     struct verge_adapter:
         sorter_facade<detail::verge_adapter_impl<FallbackSorter>>
-    {};
+    {
+        using sorter_facade<detail::verge_adapter_impl<FallbackSorter>>::sorter_facade;
+    };
 }
 
 #endif // CPPSORT_ADAPTERS_VERGE_ADAPTER_H_
@@ -28,8 +28,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <locale>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
@@ -60,16 +64,90 @@ namespace cppsort
             }
         };
 
+        ////////////////////////////////////////////////////////////
+        // ASCII fast path
+        //
+        // The classic locale only folds the ASCII letters, which
+        // can be done 8 characters at a time on a 64-bit integer:
+        // the bytes between 'A' and 'Z' are found by adding offsets
+        // to their low 7 bits and checking the highest bit, then
+        // they get their lowercase bit set
+
+        inline auto ascii_tolower(char character)
+            -> char
+        {
+            return (character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character;
+        }
+
+        inline auto ascii_tolower(std::uint64_t word)
+            -> std::uint64_t
+        {
+            constexpr std::uint64_t ones = 0x0101010101010101u;
+            constexpr std::uint64_t high_bits = ones * 0x80;
+
+            std::uint64_t heptets = word & ~high_bits;
+            std::uint64_t above_z = heptets + ones * (0x7F - 'Z');
+            std::uint64_t from_a = heptets + ones * (0x80 - 'A');
+            std::uint64_t is_upper = (from_a ^ above_z) & ~word & high_bits;
+            return word | (is_upper >> 2);
+        }
+
+        inline auto ascii_case_insensitive_less(const char* lhs, std::size_t lhs_size,
+                                                const char* rhs, std::size_t rhs_size)
+            -> bool
+        {
+            std::size_t size = std::min(lhs_size, rhs_size);
+            std::size_t pos = 0;
+            for (; pos + 8 <= size ; pos += 8) {
+                std::uint64_t left, right;
+                std::memcpy(&left, lhs + pos, 8);
+                std::memcpy(&right, rhs + pos, 8);
+                if (ascii_tolower(left) != ascii_tolower(right)) break;
+            }
+            // Find the mismatch one character at a time
+            for (; pos < size ; ++pos) {
+                char left = ascii_tolower(lhs[pos]);
+                char right = ascii_tolower(rhs[pos]);
+                if (left != right) {
+                    return left < right;
+                }
+            }
+            return lhs_size < rhs_size;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Comparison with a given ctype facet
+
+        template<typename T, typename CharT>
+        auto case_insensitive_less_impl(const T& lhs, const T& rhs,
+                                        const std::ctype<CharT>& ct, bool /* is_classic */)
+            -> bool
+        {
+            return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
+                                                std::begin(rhs), std::end(rhs),
+                                                char_less<CharT>(ct));
+        }
+
+        inline auto case_insensitive_less_impl(const std::string& lhs, const std::string& rhs,
+                                               const std::ctype<char>& ct, bool is_classic)
+            -> bool
+        {
+            if (is_classic) {
+                return ascii_case_insensitive_less(lhs.data(), lhs.size(),
+                                                   rhs.data(), rhs.size());
+            }
+            return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
+                                                std::begin(rhs), std::end(rhs),
+                                                char_less<char>(ct));
+        }
+
         template<typename T>
         auto case_insensitive_less(const T& lhs, const T& rhs, const std::locale loc)
             -> bool
         {
             using char_type = std::decay_t<decltype(*std::begin(lhs))>;
             const auto& ct = std::use_facet<std::ctype<char_type>>(loc);
-
-            return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                std::begin(rhs), std::end(rhs),
-                                                char_less<char_type>(ct));
+            return case_insensitive_less_impl(lhs, rhs, ct, loc == std::locale::classic());
         }
 
         template<typename T>
@@ -80,6 +158,44 @@ namespace cppsort
             return case_insensitive_less(lhs, rhs, loc);
         }
 
+        ////////////////////////////////////////////////////////////
+        // Case-folded key
+        //
+        // Lowercase copy of a string whose lexicographical order (the
+        // one of std::string, which compares unsigned characters) is
+        // the order of case_insensitive_less, which compares chars:
+        // the sign bit of the characters is flipped if char is signed
+
+        inline auto case_insensitive_key(const std::string& value, const std::locale& loc)
+            -> std::string
+        {
+            std::string key = value;
+            char* data = &key[0];
+            std::size_t size = key.size();
+
+            if (loc == std::locale::classic()) {
+                std::size_t pos = 0;
+                for (; pos + 8 <= size ; pos += 8) {
+                    std::uint64_t word;
+                    std::memcpy(&word, data + pos, 8);
+                    word = ascii_tolower(word);
+                    std::memcpy(data + pos, &word, 8);
+                }
+                for (; pos < size ; ++pos) {
+                    data[pos] = ascii_tolower(data[pos]);
+                }
+            } else {
+                std::use_facet<std::ctype<char>>(loc).tolower(data, data + size);
+            }
+
+            if (std::is_signed<char>::value) {
+                for (std::size_t pos = 0 ; pos < size ; ++pos) {
+                    data[pos] = static_cast<char>(static_cast<unsigned char>(data[pos]) ^ 0x80u);
+                }
+            }
+            return key;
+        }
+
         ////////////////////////////////////////////////////////////
         // Customization point
 
@@ -159,6 +275,40 @@ namespace cppsort
             }
         };
 
+        struct case_insensitive_key_locale_fn
+        {
+            private:
+
+                std::locale loc;
+
+            public:
+
+                explicit case_insensitive_key_locale_fn(const std::locale& loc):
+                    loc(loc)
+                {}
+
+                auto operator()(const std::string& value) const
+                    -> std::string
+                {
+                    return case_insensitive_key(value, loc);
+                }
+        };
+
+        struct case_insensitive_key_fn
+        {
+            auto operator()(const std::string& value) const
+                -> std::string
+            {
+                return case_insensitive_key(value, std::locale());
+            }
+
+            inline auto operator()(const std::locale& loc) const
+                -> case_insensitive_key_locale_fn
+            {
+                return case_insensitive_key_locale_fn(loc);
+            }
+        };
+
         namespace adl_barrier
         {
             // Hide the generic case_insensitive_less from the enclosing namespace
@@ -197,12 +347,14 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool is_classic;
 
                 public:
 
                     explicit refined_case_insensitive_less_locale_fn(std::locale loc):
                         loc(loc),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        is_classic(loc == std::locale::classic())
                     {}
 
                     template<typename U=T>
@@ -222,9 +374,7 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_less_impl(lhs, rhs, ct, is_classic);
                     }
             };
 
@@ -237,12 +387,14 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool is_classic;
 
                 public:
 
                     refined_case_insensitive_less_fn():
                         loc(),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        is_classic(loc == std::locale::classic())
                     {}
 
                     template<typename U=T>
@@ -278,9 +430,7 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_less_impl(lhs, rhs, ct, is_classic);
                     }
 
                     auto operator()(const std::locale& loc) const
@@ -297,6 +447,13 @@ namespace cppsort
         constexpr auto&& case_insensitive_less = utility::static_const<
             detail::case_insensitive_less_fn
         >::value;
+
+        // Projection whose results compare with operator< like the
+        // original strings compare with case_insensitive_less, which
+        // allows to sort them with radix sorters such as spread_sorter
+        constexpr auto&& case_insensitive_key = utility::static_const<
+            detail::case_insensitive_key_fn
+        >::value;
     }
 }
 
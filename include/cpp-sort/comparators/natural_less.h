@@ -27,15 +27,30 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include <cctype>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
 
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
 namespace cppsort
 {
     namespace detail
     {
+        template<typename CharT>
+        constexpr auto is_digit(CharT character)
+            -> bool
+        {
+            return character >= CharT('0') && character <= CharT('9');
+        }
+
         ////////////////////////////////////////////////////////////
         // Natural order for char sequences
 
@@ -48,11 +63,11 @@ namespace cppsort
                 auto last1 = begin1;
                 auto last2 = begin2;
                 do {
-                    if (not std::isdigit(*last1)) break;
+                    if (not is_digit(*last1)) break;
                     ++last1;
                 } while (last1 != end1);
                 do {
-                    if (not std::isdigit(*last2)) break;
+                    if (not is_digit(*last2)) break;
                     ++last2;
                 } while (last2 != end2);
 
@@ -73,12 +88,10 @@ namespace cppsort
                     if (size1 != size2) {
                         return size1 < size2;
                     }
-                    if (size1 == 0) {
-                        return false;
-                    }
 
-                    // Sizes are equal and not 0
-                    while (begin1 != end1) {
+                    // Sizes are equal, compare the digits and carry
+                    // on after the numbers if they are equal
+                    while (begin1 != last1) {
                         if (*begin1 != *begin2) {
                             return *begin1 < *begin2;
                         }
@@ -105,6 +118,35 @@ namespace cppsort
             return begin1 == end1 && begin2 != end2;
         }
 
+        ////////////////////////////////////////////////////////////
+        // Contiguous strings
+        //
+        // Strings that are sorted in natural order often share a
+        // long prefix, such as a directory or the name of a series
+        // of files: the common prefix is skipped 16 bytes at a time
+        // and the comparison starts again at the beginning of the
+        // number containing the first mismatch, if any
+
+        inline auto mismatch_position(const char* lhs, const char* rhs, std::size_t size)
+            -> std::size_t
+        {
+            std::size_t pos = 0;
+#if defined(__SSE2__)
+            for (; pos + 16 <= size ; pos += 16) {
+                __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + pos));
+                __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + pos));
+                unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(left, right)) ^ 0xFFFFu;
+                if (mask != 0) {
+                    return pos + __builtin_ctz(mask);
+                }
+            }
+#endif
+            while (pos != size && lhs[pos] == rhs[pos]) {
+                ++pos;
+            }
+            return pos;
+        }
+
         template<typename T>
         auto natural_less(const T& lhs, const T& rhs)
             -> bool
@@ -113,6 +155,74 @@ namespace cppsort
                                      std::begin(rhs), std::end(rhs));
         }
 
+        inline auto natural_less(const std::string& lhs, const std::string& rhs)
+            -> bool
+        {
+            auto pos = mismatch_position(lhs.data(), rhs.data(),
+                                         std::min(lhs.size(), rhs.size()));
+            while (pos != 0 && is_digit(lhs[pos - 1])) {
+                --pos;
+            }
+            return natural_less_impl(lhs.data() + pos, lhs.data() + lhs.size(),
+                                     rhs.data() + pos, rhs.data() + rhs.size());
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Natural order key
+        //
+        // Encodes a string into a key whose lexicographical order
+        // (the one of std::string) is the order of natural_less:
+        // every number is replaced by a digit followed by its size
+        // and its digits without the leading zeros, and the bytes
+        // are shifted so that they compare like char does
+
+        inline auto natural_key_byte(char character)
+            -> char
+        {
+            constexpr unsigned char sign_flip = std::is_signed<char>::value ? 0x80 : 0x00;
+            return static_cast<char>(static_cast<unsigned char>(character) ^ sign_flip);
+        }
+
+        inline auto natural_key(const std::string& value)
+            -> std::string
+        {
+            std::string key;
+            key.reserve(value.size() + 8);
+
+            auto first = value.begin();
+            auto last = value.end();
+            while (first != last) {
+                if (not is_digit(*first)) {
+                    key.push_back(natural_key_byte(*first));
+                    ++first;
+                    continue;
+                }
+
+                while (first != last && *first == '0') {
+                    ++first;
+                }
+                auto digits = first;
+                while (first != last && is_digit(*first)) {
+                    ++first;
+                }
+                std::size_t size = first - digits;
+
+                // Any digit compares like a number against another
+                // character, and sizes of 255 or more use 9 bytes
+                key.push_back(natural_key_byte('0'));
+                if (size < 0xFF) {
+                    key.push_back(static_cast<char>(size));
+                } else {
+                    key.push_back(static_cast<char>(0xFF));
+                    for (int shift = 56 ; shift >= 0 ; shift -= 8) {
+                        key.push_back(static_cast<char>((std::uint64_t(size) >> shift) & 0xFF));
+                    }
+                }
+                key.append(digits, first);
+            }
+            return key;
+        }
+
         ////////////////////////////////////////////////////////////
         // Customization point
 
@@ -126,6 +236,15 @@ namespace cppsort
                 return natural_less(std::forward<T>(lhs), std::forward<U>(rhs));
             }
         };
+
+        struct natural_key_fn
+        {
+            auto operator()(const std::string& value) const
+                -> std::string
+            {
+                return natural_key(value);
+            }
+        };
     }
 
     namespace
@@ -133,6 +252,13 @@ namespace cppsort
         constexpr auto&& natural_less = utility::static_const<
             detail::natural_less_fn
         >::value;
+
+        // Projection whose results compare with operator< like the
+        // original strings compare with natural_less, which allows
+        // to compute the keys once with schwartz_adapter
+        constexpr auto&& natural_key = utility::static_const<
+            detail::natural_key_fn
+        >::value;
     }
 }
 
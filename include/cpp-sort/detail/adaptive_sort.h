@@ -0,0 +1,181 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_ADAPTIVE_SORT_H_
+#define CPPSORT_DETAIL_ADAPTIVE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/sampled_rem.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "bitops.h"
+#include "drop_merge_sort.h"
+#include "iterator_traits.h"
+#include "pdqsort.h"
+#include "reverse.h"
+#include "ska_sort.h"
+#include "vergesort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    // Below this size, pdqsort is used without probing
+    constexpr std::ptrdiff_t adaptive_sort_threshold = 256;
+
+    // Number of elements sampled to estimate Rem
+    constexpr std::ptrdiff_t adaptive_sort_sample_size = 1024;
+
+    // Proportion of elements to remove to get a sorted sequence
+    // below which drop-merge sort beats the general sorts
+    constexpr double adaptive_sort_max_rem_ratio = 0.2;
+
+    ////////////////////////////////////////////////////////////
+    // Probes
+
+    // Counts the runs vergesort would find, which are either
+    // non-decreasing or strictly decreasing, but stops as soon
+    // as there are more than limit of them: for shuffled data it
+    // only reads a handful of elements
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto count_runs(RandomAccessIterator first, RandomAccessIterator last,
+                    difference_type_t<RandomAccessIterator> limit,
+                    Compare compare, Projection projection)
+        -> difference_type_t<RandomAccessIterator>
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        difference_type_t<RandomAccessIterator> runs = 0;
+        while (first != last && runs <= limit) {
+            ++runs;
+            auto next = std::next(first);
+            if (next == last) break;
+
+            if (comp(proj(*next), proj(*first))) {
+                do {
+                    ++first;
+                    ++next;
+                } while (next != last && comp(proj(*next), proj(*first)));
+            } else {
+                do {
+                    ++first;
+                    ++next;
+                } while (next != last && not comp(proj(*next), proj(*first)));
+            }
+            first = next;
+        }
+        return runs;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Fallback for shuffled data
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto adaptive_unsorted_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare, Projection projection, std::true_type)
+        -> void
+    {
+        ska_sort(std::move(first), std::move(last), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto adaptive_unsorted_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare, Projection projection, std::false_type)
+        -> void
+    {
+        pdqsort(std::move(first), std::move(last),
+                std::move(compare), std::move(projection));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Adaptive sort
+    //
+    // Probes the presortedness of the collection and picks an
+    // algorithm accordingly:
+    // - nothing for sorted collections, a reversal for strictly
+    //   descending ones
+    // - vergesort when there are at most log2(n) ascending or
+    //   descending runs
+    // - drop-merge sort when few elements are out of place
+    // - ska_sort when it can sort the elements, pdqsort otherwise
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto adaptive_sort(RandomAccessIterator first, RandomAccessIterator last,
+                       Compare compare, Projection projection,
+                       utility::memory_resource* resource)
+        -> void
+    {
+        auto size = std::distance(first, last);
+        if (size < adaptive_sort_threshold) {
+            pdqsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        auto log_size = static_cast<decltype(size)>(detail::log2(size));
+        auto runs = count_runs(first, last, log_size, compare, projection);
+        if (runs == 1) {
+            // Either sorted or strictly descending
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+            if (comp(proj(*std::prev(last)), proj(*first))) {
+                detail::reverse(std::move(first), std::move(last));
+            }
+            return;
+        }
+
+        if (runs <= log_size) {
+            vergesort(std::move(first), std::move(last),
+                      std::move(compare), std::move(projection),
+                      resource);
+            return;
+        }
+
+        auto removed = probe::sampled_rem_probe(adaptive_sort_sample_size)(first, last, compare, projection);
+        if (removed <= adaptive_sort_max_rem_ratio * size) {
+            drop_merge_sort(std::move(first), std::move(last),
+                            std::move(compare), std::move(projection),
+                            resource);
+            return;
+        }
+
+        using projected_t = std::decay_t<decltype(utility::as_function(projection)(*first))>;
+        using use_ska_sort = std::integral_constant<bool,
+            std::is_same<Compare, std::less<>>::value &&
+            is_ska_sortable_v<projected_t>
+        >;
+        adaptive_unsorted_sort(std::move(first), std::move(last),
+                               std::move(compare), std::move(projection),
+                               use_ska_sort{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_ADAPTIVE_SORT_H_
@@ -0,0 +1,199 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+#define CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "move.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Reorders [first, last) so that the element at position i
+    // is the element that was at position indices[i] before the
+    // call, moving every element exactly once along the cycles
+    // of the permutation
+    //
+    // The projection gives access to the index stored in every
+    // element of indices, which allows to use it on records that
+    // carry an index along with other data
+    //
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename Projection,
+        typename IsPlaced,
+        typename MarkPlaced
+    >
+    auto apply_permutation_cycles(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                  RandomAccessIterator2 indices, Projection projection,
+                                  IsPlaced is_placed, MarkPlaced mark_placed)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator1>;
+        auto&& proj = utility::as_function(projection);
+
+        difference_type size = last - first;
+        for (difference_type start = 0 ; start < size ; ++start) {
+            if (is_placed(start)) continue;
+            difference_type next = proj(indices[start]);
+            if (next == start) continue;
+
+            // Follow the cycle starting at position start
+            auto tmp = iter_move(first + start);
+            difference_type current = start;
+            do {
+                first[current] = iter_move(first + next);
+                mark_placed(current);
+                current = next;
+                next = proj(indices[current]);
+            } while (next != start);
+            first[current] = std::move(tmp);
+            mark_placed(current);
+        }
+    }
+
+    // The indices are only read: the positions already handled
+    // are recorded in a separate bitmap
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename Projection = utility::identity
+    >
+    auto apply_permutation(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                           RandomAccessIterator2 indices, Projection projection={})
+        -> void
+    {
+        std::vector<bool> visited(last - first);
+        apply_permutation_cycles(
+            first, last, std::move(indices), std::move(projection),
+            [&visited](auto pos) -> bool { return visited[pos]; },
+            [&visited](auto pos) { visited[pos] = true; }
+        );
+    }
+
+    // The positions already handled are marked in-band by
+    // writing pos into indices[pos], no additional memory is
+    // needed but the indices are left as the identity permutation
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename Projection = utility::identity
+    >
+    auto apply_permutation_in_band(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                   RandomAccessIterator2 indices, Projection projection={})
+        -> void
+    {
+        auto&& proj = utility::as_function(projection);
+        apply_permutation_cycles(
+            first, last, indices, projection,
+            [](auto) { return false; },
+            [&proj, indices](auto pos) {
+                using index_t = std::decay_t<decltype(proj(indices[pos]))>;
+                proj(indices[pos]) = static_cast<index_t>(pos);
+            }
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Apply a permutation with a buffer
+    //
+    // Same contract as above, except that the elements are
+    // gathered in their final order in a temporary buffer when
+    // there is enough memory, which is much faster than following
+    // the cycles for big collections
+
+    template<typename IndexIterator, typename Projection, typename RandomAccessIterator>
+    auto apply_permutation_one(IndexIterator indices, difference_type_t<IndexIterator> size,
+                               Projection projection, RandomAccessIterator first)
+        -> void
+    {
+        using utility::iter_move;
+        using value_t = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+        auto&& proj = utility::as_function(projection);
+        static_assert(std::is_integral<std::decay_t<decltype(proj(*indices))>>::value,
+                      "apply_permutation requires integral indices");
+
+        auto buffer = get_temporary_buffer<value_t>(nullptr, size);
+        if (buffer.second < size) {
+            // Not enough memory, follow the cycles of the
+            // permutation instead, which is slower for big
+            // collections since every move depends on the
+            // previous one
+            apply_permutation(first, first + size, std::move(indices),
+                              std::move(projection));
+            return;
+        }
+
+        // Gather the elements in their final order: unlike when
+        // following the cycles, the reads are independent from
+        // each other and the memory accesses can overlap
+        destruct_n<value_t> d(0);
+        std::unique_ptr<value_t, destruct_n<value_t>&> h2(buffer.first.get(), d);
+        auto ptr = buffer.first.get();
+        for (difference_type_t<IndexIterator> pos = 0 ; pos < size ; ++d, (void) ++pos, ++ptr) {
+            ::new(ptr) value_t(iter_move(first + proj(indices[pos])));
+        }
+        detail::move(buffer.first.get(), buffer.first.get() + size, std::move(first));
+    }
+
+    template<typename IndexIterator, typename Projection>
+    auto apply_permutation_n(IndexIterator, difference_type_t<IndexIterator>, Projection)
+        -> void
+    {
+        // No collection to reorder
+    }
+
+    template<typename IndexIterator, typename Projection,
+             typename... RandomAccessIterators>
+    auto apply_permutation_n(IndexIterator indices, difference_type_t<IndexIterator> size,
+                             Projection projection, RandomAccessIterators... firsts)
+        -> void
+    {
+        (void) std::initializer_list<int>{
+            (apply_permutation_one(indices, size, projection, std::move(firsts)), 0)...
+        };
+    }
+}}
+
+#endif // CPPSORT_DETAIL_APPLY_PERMUTATION_H_
@@ -28,16 +28,139 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
 #include "iterator_traits.h"
+#include "memory.h"
 #include "minmax_element_and_is_sorted.h"
+#include "move.h"
+#include "reverse.h"
+#include "ska_sort.h"
 
 namespace cppsort
 {
 namespace detail
 {
+    ////////////////////////////////////////////////////////////
+    // Sparse ranges of values
+    //
+    // The counts take memory proportional to the range of the
+    // values, so a single outlier is enough to make them huge:
+    // when there would be more than a few counters per element,
+    // the collection is sorted with a radix sort instead, whose
+    // memory use only depends on the number of elements
+
+    template<typename Integer>
+    using counting_sort_unsigned_t = std::make_unsigned_t<decltype(+std::declval<Integer>())>;
+
+    template<typename Integer>
+    auto is_sparse_range(Integer min, Integer max, std::uintmax_t size)
+        -> bool
+    {
+        using unsigned_t = counting_sort_unsigned_t<Integer>;
+        std::uintmax_t range = unsigned_t(unsigned_t(max) - unsigned_t(min));
+        return range > 4 * size + 256;
+    }
+
+    // Stable LSD radix sort on the rank of the keys in [min, max],
+    // one byte at a time; the elements go back and forth between
+    // two buffers, which works with forward iterators
+    template<typename ForwardIterator, typename Projection, typename Integer>
+    auto stable_radix_sort(ForwardIterator first, ForwardIterator last,
+                           difference_type_t<ForwardIterator> size,
+                           Projection projection, Integer min, Integer max, bool reverse)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<ForwardIterator>;
+        using value_type = value_type_t<ForwardIterator>;
+        using unsigned_t = counting_sort_unsigned_t<Integer>;
+        auto&& proj = utility::as_function(projection);
+
+        auto rank = [&](const auto& key) {
+            return reverse ? unsigned_t(unsigned_t(max) - unsigned_t(key))
+                           : unsigned_t(unsigned_t(key) - unsigned_t(min));
+        };
+        unsigned_t range = rank(reverse ? min : max);
+
+        // Moves the elements of [src_first, src_last) to their bucket
+        // for the byte at the given shift, constructing them in dest
+        auto scatter = [&](auto src_first, auto src_last, value_type* dest, unsigned shift) {
+            difference_type offsets[256] = {};
+            for (auto it = src_first ; it != src_last ; ++it) {
+                ++offsets[(rank(proj(*it)) >> shift) & 0xFF];
+            }
+            difference_type total = 0;
+            for (auto& offset: offsets) {
+                auto count = offset;
+                offset = total;
+                total += count;
+            }
+            // The elements are not constructed in order, so they
+            // are only destroyed once the whole buffer is filled
+            for (auto it = src_first ; it != src_last ; ++it) {
+                auto& offset = offsets[(rank(proj(*it)) >> shift) & 0xFF];
+                ::new(dest + offset) value_type(iter_move(it));
+                ++offset;
+            }
+        };
+
+        auto buffer = allocate_buffer<value_type>(nullptr, size);
+        scatter(first, last, buffer.get(), 0);
+        destruct_n<value_type> d(size);
+        std::unique_ptr<value_type, destruct_n<value_type>&> h2(buffer.get(), d);
+
+        if (sizeof(unsigned_t) > 1 && (range >> 8) != 0) {
+            auto other_buffer = allocate_buffer<value_type>(nullptr, size);
+            for (unsigned shift = 8 ; shift < sizeof(unsigned_t) * 8 && (range >> shift) != 0 ; shift += 8) {
+                scatter(buffer.get(), buffer.get() + size, other_buffer.get(), shift);
+                h2.reset();
+                std::swap(buffer, other_buffer);
+                h2.reset(buffer.get());
+            }
+        }
+
+        detail::move(buffer.get(), buffer.get() + size, std::move(first));
+    }
+
+    template<typename ForwardIterator, typename Integer>
+    auto sparse_counting_sort(ForwardIterator first, ForwardIterator last,
+                              difference_type_t<ForwardIterator> size,
+                              Integer min, Integer max, bool reverse,
+                              std::forward_iterator_tag)
+        -> void
+    {
+        stable_radix_sort(std::move(first), std::move(last), size,
+                          utility::identity{}, min, max, reverse);
+    }
+
+    template<typename RandomAccessIterator, typename Integer>
+    auto sparse_counting_sort(RandomAccessIterator first, RandomAccessIterator last,
+                              difference_type_t<RandomAccessIterator>,
+                              Integer, Integer, bool reverse,
+                              std::random_access_iterator_tag)
+        -> void
+    {
+        // Equal integers can't be told apart, so an in-place
+        // unstable radix sort is fine
+        ska_sort(first, last, utility::identity{});
+        if (reverse) {
+            detail::reverse(std::move(first), std::move(last));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Counting sort
+
     template<typename ForwardIterator>
     auto counting_sort(ForwardIterator first, ForwardIterator last)
         -> void
@@ -48,6 +171,14 @@ namespace detail
         using difference_type = difference_type_t<ForwardIterator>;
         auto min = *info.min;
         auto max = *info.max;
+
+        auto size = std::distance(first, last);
+        if (is_sparse_range(min, max, size)) {
+            sparse_counting_sort(std::move(first), std::move(last), size, min, max, false,
+                                 iterator_category_t<ForwardIterator>{});
+            return;
+        }
+
         std::vector<difference_type> counts(max - min + 1, 0);
 
         for (auto it = first ; it != last ; ++it)
@@ -71,6 +202,14 @@ namespace detail
         using difference_type = difference_type_t<ForwardIterator>;
         auto min = *info.max;
         auto max = *info.min;
+
+        auto size = std::distance(first, last);
+        if (is_sparse_range(min, max, size)) {
+            sparse_counting_sort(std::move(first), std::move(last), size, min, max, true,
+                                 iterator_category_t<ForwardIterator>{});
+            return;
+        }
+
         std::vector<difference_type> counts(max - min + 1, 0);
 
         for (auto it = first ; it != last ; ++it)
@@ -84,6 +223,73 @@ namespace detail
             first = std::fill_n(first, count, max--);
         }
     }
+
+    ////////////////////////////////////////////////////////////
+    // Stable counting sort of records with integer keys
+    //
+    // The elements can't be rebuilt from the counts anymore: the
+    // counts are turned into the offsets of every key in a buffer
+    // where the elements are moved in order, then moved back. The
+    // keys are indexed by their rank in the sorted collection, so
+    // the reverse sort uses max - key instead of key - min
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto stable_counting_sort(ForwardIterator first, ForwardIterator last,
+                              Compare compare, Projection projection)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<ForwardIterator>;
+        using value_type = value_type_t<ForwardIterator>;
+        constexpr bool reverse = std::is_same<Compare, std::greater<>>::value;
+        auto&& proj = utility::as_function(projection);
+
+        auto info = minmax_element_and_is_sorted(first, last, compare, projection);
+        if (info.is_sorted) return;
+
+        auto min = proj(*(reverse ? info.max : info.min));
+        auto max = proj(*(reverse ? info.min : info.max));
+
+        auto size = std::distance(first, last);
+        if (is_sparse_range(min, max, size)) {
+            stable_radix_sort(std::move(first), std::move(last), size,
+                              std::move(projection), min, max, reverse);
+            return;
+        }
+
+        auto index_of = [&](const auto& key) {
+            return reverse ? difference_type(max - key) : difference_type(key - min);
+        };
+
+        // Offset of the first element with every key
+        std::vector<difference_type> offsets(max - min + 1, 0);
+        for (auto it = first ; it != last ; ++it)
+        {
+            ++offsets[index_of(proj(*it))];
+        }
+        difference_type total = 0;
+        for (auto& offset: offsets)
+        {
+            auto count = offset;
+            offset = total;
+            total += count;
+        }
+
+        // Move the elements to their place in the buffer; they are
+        // not constructed in order, so only destroy them once the
+        // whole buffer has been filled
+        auto buffer = allocate_buffer<value_type>(nullptr, size);
+        for (auto it = first ; it != last ; ++it)
+        {
+            auto& offset = offsets[index_of(proj(*it))];
+            ::new(buffer.get() + offset) value_type(iter_move(it));
+            ++offset;
+        }
+        destruct_n<value_type> d(size);
+        std::unique_ptr<value_type, destruct_n<value_type>&> h2(buffer.get(), d);
+
+        detail::move(buffer.get(), buffer.get() + size, std::move(first));
+    }
 }}
 
 #endif // CPPSORT_DETAIL_COUNTING_SORT_H_
@@ -30,7 +30,9 @@
 #include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/memory_resource.h>
 #include "iterator_traits.h"
+#include "memory.h"
 #include "pdqsort.h"
 
 namespace cppsort
@@ -43,7 +45,7 @@ namespace detail
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto drop_merge_sort(BidirectionalIterator begin, BidirectionalIterator end,
                          Compare compare, Projection projection,
-                         std::true_type)
+                         utility::memory_resource* resource, std::true_type)
         -> void
     {
         auto size = std::distance(begin, end);
@@ -54,7 +56,7 @@ namespace detail
 
         using difference_type = difference_type_t<BidirectionalIterator>;
         using value_type = value_type_t<BidirectionalIterator>;
-        std::vector<value_type> dropped;
+        std::vector<value_type, resource_allocator<value_type>> dropped(resource);
 
         difference_type num_dropped_in_row = 0;
         auto write = begin;
@@ -97,7 +99,7 @@ namespace detail
         }
 
         // Sort the dropped elements
-        pdqsort(std::begin(dropped), std::end(dropped), compare, projection);
+        pdqsort(dropped.data(), dropped.data() + dropped.size(), compare, projection);
 
         auto back = end;
 
@@ -119,7 +121,7 @@ namespace detail
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto drop_merge_sort(BidirectionalIterator begin, BidirectionalIterator end,
                          Compare compare, Projection projection,
-                         std::false_type)
+                         utility::memory_resource* resource, std::false_type)
         -> void
     {
         using utility::iter_move;
@@ -132,7 +134,7 @@ namespace detail
 
         using difference_type = difference_type_t<BidirectionalIterator>;
         using rvalue_reference = std::decay_t<rvalue_reference_t<BidirectionalIterator>>;
-        std::vector<rvalue_reference> dropped;
+        std::vector<rvalue_reference, resource_allocator<rvalue_reference>> dropped(resource);
 
         difference_type num_dropped_in_row = 0;
         auto write = begin;
@@ -168,7 +170,12 @@ namespace detail
                     num_dropped_in_row = 0;
                 }
             } else {
-                *write = iter_move(read);
+                // Self-move-assignment may leave the element in a
+                // valid but unspecified state, which empties some
+                // std::string implementations
+                if (write != read) {
+                    *write = iter_move(read);
+                }
                 ++read;
                 ++write;
                 num_dropped_in_row = 0;
@@ -176,7 +183,7 @@ namespace detail
         }
 
         // Sort the dropped elements
-        pdqsort(std::begin(dropped), std::end(dropped), compare, projection);
+        pdqsort(dropped.data(), dropped.data() + dropped.size(), compare, projection);
 
         auto back = end;
 
@@ -196,13 +203,14 @@ namespace detail
 
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto drop_merge_sort(BidirectionalIterator first, BidirectionalIterator last,
-                         Compare compare, Projection projection)
+                         Compare compare, Projection projection,
+                         utility::memory_resource* resource)
         -> void
     {
         using value_type = value_type_t<BidirectionalIterator>;
         drop_merge_sort(std::move(first), std::move(last),
                         std::move(compare), std::move(projection),
-                        std::is_trivially_copyable<value_type>{});
+                        resource, std::is_trivially_copyable<value_type>{});
     }
 }}
 
@@ -58,6 +58,78 @@ namespace detail
                 return comp(proj(*lhs), proj(*rhs));
             }
     };
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    class indexed_compare
+    {
+        private:
+
+            RandomAccessIterator first;
+            // Pack compare and projection for EBCO
+            std::tuple<Compare, Projection> data;
+
+        public:
+
+            indexed_compare(RandomAccessIterator first, Compare compare, Projection projection):
+                first(std::move(first)),
+                data(std::move(compare), std::move(projection))
+            {}
+
+            template<typename Index>
+            auto operator()(Index lhs, Index rhs)
+                -> bool
+            {
+                auto&& comp = utility::as_function(std::get<0>(data));
+                auto&& proj = utility::as_function(std::get<1>(data));
+                return comp(proj(first[lhs]), proj(first[rhs]));
+            }
+    };
+
+    template<typename RandomAccessIterator, typename Projection>
+    class indexed_projection
+    {
+        private:
+
+            RandomAccessIterator first;
+            Projection projection;
+
+        public:
+
+            indexed_projection(RandomAccessIterator first, Projection projection):
+                first(std::move(first)),
+                projection(std::move(projection))
+            {}
+
+            template<typename Index>
+            auto operator()(Index index) const
+                -> decltype(utility::as_function(projection)(first[index]))
+            {
+                auto&& proj = utility::as_function(projection);
+                return proj(first[index]);
+            }
+    };
+
+    template<typename Projection>
+    class indirect_projection
+    {
+        private:
+
+            Projection projection;
+
+        public:
+
+            explicit indirect_projection(Projection projection):
+                projection(std::move(projection))
+            {}
+
+            template<typename Iterator>
+            auto operator()(const Iterator& it) const
+                -> decltype(utility::as_function(projection)(*it))
+            {
+                auto&& proj = utility::as_function(projection);
+                return proj(*it);
+            }
+    };
 }}
 
 #endif // CPPSORT_DETAIL_INDIRECT_COMPARE_H_
@@ -41,6 +41,7 @@
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/memory_resource.h>
 #include "assume.h"
 #include "iterator_traits.h"
 #include "lower_bound.h"
@@ -211,7 +212,7 @@ namespace detail
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto inplace_merge(ForwardIterator first, ForwardIterator middle,
                        ForwardIterator last, Compare compare, Projection projection,
-                       std::forward_iterator_tag)
+                       utility::memory_resource* resource, std::forward_iterator_tag)
         -> void
     {
         using rvalue_reference = std::decay_t<rvalue_reference_t<ForwardIterator>>;
@@ -228,14 +229,10 @@ namespace detail
         auto n0 = std::distance(first, middle);
         auto n1 = std::distance(middle, last);
 
-        auto buffer = std::get_temporary_buffer<rvalue_reference>(std::max(n0, n1));
-        std::unique_ptr<
-            rvalue_reference,
-            temporary_buffer_deleter
-        > ptr(buffer.first);
+        auto buffer = get_temporary_buffer<rvalue_reference>(resource, std::max(n0, n1));
 
         merge_n_adaptative(std::move(first), n0, std::move(middle), n1,
-                           buffer.first, buffer.second,
+                           buffer.first.get(), buffer.second,
                            std::move(compare), std::move(projection));
     }
 
@@ -395,7 +392,8 @@ namespace detail
 
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto inplace_merge(BidirectionalIterator first, BidirectionalIterator middle,
-                       BidirectionalIterator last, Compare compare, Projection projection)
+                       BidirectionalIterator last, Compare compare, Projection projection,
+                       utility::memory_resource* resource=nullptr)
         -> void
     {
         using rvalue_reference = std::decay_t<rvalue_reference_t<BidirectionalIterator>>;
@@ -403,14 +401,12 @@ namespace detail
         difference_type len1 = std::distance(first, middle);
         difference_type len2 = std::distance(middle, last);
         difference_type buff_size = std::min(len1, len2);
-        std::pair<rvalue_reference*, std::ptrdiff_t> buff
-            = std::get_temporary_buffer<rvalue_reference>(buff_size);
-        std::unique_ptr<rvalue_reference, temporary_buffer_deleter> h(buff.first);
+        auto buff = get_temporary_buffer<rvalue_reference>(resource, buff_size);
 
         using Comp_ref = std::add_lvalue_reference_t<Compare>;
         return inplace_merge_impl<Comp_ref>(std::move(first), std::move(middle), std::move(last),
                                             compare, std::move(projection),
-                                            len1, len2, buff.first, buff.second);
+                                            len1, len2, buff.first.get(), buff.second);
     }
 
     ////////////////////////////////////////////////////////////
@@ -419,12 +415,11 @@ namespace detail
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto inplace_merge(ForwardIterator first, ForwardIterator middle,
                        ForwardIterator last, Compare compare, Projection projection,
-                       std::bidirectional_iterator_tag)
+                       utility::memory_resource* resource, std::bidirectional_iterator_tag)
         -> void
     {
-        using category = iterator_category_t<ForwardIterator>;
         inplace_merge(std::move(first), std::move(middle), std::move(last),
-                      std::move(compare), std::move(projection), category{});
+                      std::move(compare), std::move(projection), resource);
     }
 }}
 
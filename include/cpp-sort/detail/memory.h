@@ -19,6 +19,8 @@
 #include <memory>
 #include <new>
 #include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/memory_resource.h>
 
 namespace cppsort
 {
@@ -26,31 +28,203 @@ namespace detail
 {
     ////////////////////////////////////////////////////////////
     // Deleter for ::operator new(std::size_t)
+    //
+    // When constructed with a memory resource, the memory is
+    // assumed to come from that resource instead, and the
+    // deleter has to know the number of allocated objects
 
     struct operator_deleter
     {
+        operator_deleter() = default;
+
+        operator_deleter(utility::memory_resource* resource, std::size_t size) noexcept:
+            resource(resource),
+            size(size)
+        {}
+
         template<typename T>
         auto operator()(T* pointer) const noexcept
             -> void
         {
-            ::operator delete(pointer);
+            if (resource) {
+                resource->deallocate(pointer, size * sizeof(T), alignof(T));
+            } else {
+                ::operator delete(pointer);
+            }
         }
+
+        utility::memory_resource* resource = nullptr;
+        std::size_t size = 0;
     };
 
+    // Allocates uninitialized memory for size objects of type T
+    // with the given memory resource, or with ::operator new when
+    // there is no memory resource
+    template<typename T>
+    auto allocate_buffer(utility::memory_resource* resource, std::size_t size)
+        -> std::unique_ptr<T, operator_deleter>
+    {
+        if (resource) {
+            void* memory = resource->allocate(size * sizeof(T), alignof(T));
+            return { static_cast<T*>(memory), operator_deleter(resource, size) };
+        }
+        return std::unique_ptr<T, operator_deleter>(
+            static_cast<T*>(::operator new(size * sizeof(T)))
+        );
+    }
+
     ////////////////////////////////////////////////////////////
     // Deleter for std::get_temporary_buffer
+    //
+    // Same as above: the buffer is returned to the memory
+    // resource if any
 
     struct temporary_buffer_deleter
     {
+        temporary_buffer_deleter() = default;
+
+        temporary_buffer_deleter(utility::memory_resource* resource, std::size_t size) noexcept:
+            resource(resource),
+            size(size)
+        {}
+
         template<typename T>
-        auto operator()(T* pointer) const
-            noexcept(noexcept(std::return_temporary_buffer(pointer)))
+        auto operator()(T* pointer) const noexcept
             -> void
         {
-            std::return_temporary_buffer(pointer);
+            if (resource) {
+                resource->deallocate(pointer, size * sizeof(T), alignof(T));
+            } else {
+                std::return_temporary_buffer(pointer);
+            }
         }
+
+        utility::memory_resource* resource = nullptr;
+        std::size_t size = 0;
     };
 
+    // Unlike std::get_temporary_buffer, memory resources always
+    // allocate the requested size or throw
+    template<typename T>
+    auto get_temporary_buffer(utility::memory_resource* resource, std::ptrdiff_t size)
+        -> std::pair<std::unique_ptr<T[], temporary_buffer_deleter>, std::ptrdiff_t>
+    {
+        using buffer_t = std::unique_ptr<T[], temporary_buffer_deleter>;
+
+        if (resource) {
+            if (size <= 0) {
+                return { buffer_t(nullptr), 0 };
+            }
+            void* memory = resource->allocate(size * sizeof(T), alignof(T));
+            return {
+                buffer_t(static_cast<T*>(memory), temporary_buffer_deleter(resource, size)),
+                size
+            };
+        }
+        auto buffer = std::get_temporary_buffer<T>(size);
+        return { buffer_t(buffer.first), buffer.second };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Standard allocator wrapping a memory resource, falls back
+    // to ::operator new when there is no memory resource
+
+    template<typename T>
+    struct resource_allocator
+    {
+        using value_type = T;
+
+        resource_allocator(utility::memory_resource* resource=nullptr) noexcept:
+            resource(resource)
+        {}
+
+        template<typename U>
+        resource_allocator(const resource_allocator<U>& other) noexcept:
+            resource(other.resource)
+        {}
+
+        auto allocate(std::size_t size)
+            -> T*
+        {
+            if (resource) {
+                return static_cast<T*>(resource->allocate(size * sizeof(T), alignof(T)));
+            }
+            return static_cast<T*>(::operator new(size * sizeof(T)));
+        }
+
+        auto deallocate(T* pointer, std::size_t size) noexcept
+            -> void
+        {
+            operator_deleter(resource, size)(pointer);
+        }
+
+        utility::memory_resource* resource;
+    };
+
+    template<typename T, typename U>
+    auto operator==(const resource_allocator<T>& lhs, const resource_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.resource == rhs.resource;
+    }
+
+    template<typename T, typename U>
+    auto operator!=(const resource_allocator<T>& lhs, const resource_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.resource != rhs.resource;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Base class for the sorters and adapters that can take a
+    // memory resource to allocate their buffers, a null memory
+    // resource means that the default allocation functions are
+    // used instead
+
+    class uses_memory_resource
+    {
+        public:
+
+            constexpr uses_memory_resource() noexcept = default;
+
+            constexpr explicit uses_memory_resource(utility::memory_resource* resource) noexcept:
+                _resource(resource)
+            {}
+
+            constexpr auto resource() const noexcept
+                -> utility::memory_resource*
+            {
+                return _resource;
+            }
+
+        private:
+
+            utility::memory_resource* _resource = nullptr;
+    };
+
+    // Adapters call this function to pass their memory resource
+    // to the adapted sorter when it accepts one
+
+    template<typename Sorter>
+    auto make_sorter_with_resource(utility::memory_resource* resource)
+        -> std::enable_if_t<
+            std::is_constructible<Sorter, utility::memory_resource*>::value,
+            Sorter
+        >
+    {
+        return Sorter(resource);
+    }
+
+    template<typename Sorter>
+    auto make_sorter_with_resource(utility::memory_resource*)
+        -> std::enable_if_t<
+            not std::is_constructible<Sorter, utility::memory_resource*>::value,
+            Sorter
+        >
+    {
+        return Sorter{};
+    }
+
     ////////////////////////////////////////////////////////////
     // Deleter for placement new-allocated memory
 
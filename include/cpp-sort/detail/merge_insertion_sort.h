@@ -37,6 +37,7 @@
 #include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/memory_resource.h>
 #include "iterator_traits.h"
 #include "memory.h"
 #include "move.h"
@@ -292,7 +293,8 @@ namespace detail
     >
     auto merge_insertion_sort_impl(group_iterator<RandomAccessIterator> first,
                                    group_iterator<RandomAccessIterator> last,
-                                   Compare compare, Projection projection)
+                                   Compare compare, Projection projection,
+                                   utility::memory_resource* resource)
         -> void
     {
         // Cache all the differences between a Jacobsthal number and its
@@ -338,7 +340,7 @@ namespace detail
         merge_insertion_sort_impl(
             make_group_iterator(first, 2),
             make_group_iterator(end, 2),
-            compare, projection
+            compare, projection, resource
         );
 
         ////////////////////////////////////////////////////////////
@@ -347,10 +349,17 @@ namespace detail
         // The first pend element is always part of the main chain,
         // so we can safely initialize the list with the first two
         // elements of the sequence
-        std::list<group_iterator<RandomAccessIterator>> chain = { first, std::next(first) };
+        using list_t = std::list<
+            group_iterator<RandomAccessIterator>,
+            resource_allocator<group_iterator<RandomAccessIterator>>
+        >;
+        list_t chain({ first, std::next(first) }, resource);
 
         // Upper bounds for the insertion of pend elements
-        std::vector<typename std::list<group_iterator<RandomAccessIterator>>::iterator> pend;
+        std::vector<
+            typename list_t::iterator,
+            resource_allocator<typename list_t::iterator>
+        > pend(resource);
         pend.reserve((size + 1) / 2 - 1);
 
         for (auto it = first + 2 ; it != end ; it += 2)
@@ -379,7 +388,7 @@ namespace detail
             // a positive number, so there is of risk comparing funny values
             using size_type = std::common_type_t<
                 std::uint_fast64_t,
-                typename std::list<group_iterator<RandomAccessIterator>>::difference_type
+                typename list_t::difference_type
             >;
 
             // Find next index
@@ -430,9 +439,7 @@ namespace detail
         auto full_size = size * first.size();
 
         using rvalue_reference = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
-        std::unique_ptr<rvalue_reference, operator_deleter> cache(
-            static_cast<rvalue_reference*>(::operator new(full_size * sizeof(rvalue_reference)))
-        );
+        auto cache = allocate_buffer<rvalue_reference>(resource, full_size);
         destruct_n<rvalue_reference> d(0);
         std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(cache.get(), d);
 
@@ -457,13 +464,15 @@ namespace detail
         typename Projection
     >
     auto merge_insertion_sort(RandomAccessIterator first, RandomAccessIterator last,
-                              Compare compare, Projection projection)
+                              Compare compare, Projection projection,
+                              utility::memory_resource* resource)
         -> void
     {
         merge_insertion_sort_impl(
             make_group_iterator(std::move(first), 1),
             make_group_iterator(std::move(last), 1),
-            std::move(compare), std::move(projection)
+            std::move(compare), std::move(projection),
+            resource
         );
     }
 }}
@@ -33,6 +33,7 @@
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/memory_resource.h>
 #include "bubble_sort.h"
 #include "inplace_merge.h"
 #include "insertion_sort.h"
@@ -44,7 +45,7 @@ namespace cppsort
 namespace detail
 {
     // std::unique_ptr to handle memory allocated with
-    // std::get_temporary_buffer
+    // get_temporary_buffer
     template<typename T>
     using buffer_ptr = std::unique_ptr<std::decay_t<T>[], temporary_buffer_deleter>;
 
@@ -52,6 +53,7 @@ namespace detail
     auto merge_sort_impl(ForwardIterator first, difference_type_t<ForwardIterator> size,
                          buffer_ptr<rvalue_reference_t<ForwardIterator>>&& buffer,
                          std::ptrdiff_t& buff_size,
+                         utility::memory_resource* resource,
                          Compare compare, Projection projection)
         -> buffer_ptr<rvalue_reference_t<ForwardIterator>>
     {
@@ -71,12 +73,12 @@ namespace detail
         // Recursively sort the partitions
         buffer = std::move(merge_sort_impl(
             first, size_left,
-            std::move(buffer), buff_size,
+            std::move(buffer), buff_size, resource,
             compare, projection
         ));
         buffer = std::move(merge_sort_impl(
             middle, size - size_left,
-            std::move(buffer), buff_size,
+            std::move(buffer), buff_size, resource,
             compare, projection
         ));
 
@@ -93,8 +95,9 @@ namespace detail
         // Try to increase the memory buffer if it not big enough
         if (buff_size < size - (size / 2)) {
             using rvalue_reference = std::decay_t<rvalue_reference_t<ForwardIterator>>;
-            auto new_buffer = std::get_temporary_buffer<rvalue_reference>(size - (size / 2));
-            buffer.reset(new_buffer.first);
+            buffer.reset();
+            auto new_buffer = get_temporary_buffer<rvalue_reference>(resource, size - (size / 2));
+            buffer = std::move(new_buffer.first);
             buff_size = new_buffer.second;
         }
 
@@ -111,6 +114,7 @@ namespace detail
                          difference_type_t<BidirectionalIterator> size,
                          buffer_ptr<rvalue_reference_t<BidirectionalIterator>>&& buffer,
                          std::ptrdiff_t& buff_size,
+                         utility::memory_resource* resource,
                          Compare compare, Projection projection)
         -> buffer_ptr<rvalue_reference_t<BidirectionalIterator>>
     {
@@ -130,12 +134,12 @@ namespace detail
         // Recursively sort the partitions
         buffer = std::move(merge_sort_impl(
             first, middle, size_left,
-            std::move(buffer), buff_size,
+            std::move(buffer), buff_size, resource,
             compare, projection
         ));
         buffer = std::move(merge_sort_impl(
             middle, last, size - size_left,
-            std::move(buffer), buff_size,
+            std::move(buffer), buff_size, resource,
             compare, projection
         ));
 
@@ -152,8 +156,9 @@ namespace detail
         // Try to increase the memory buffer if it not big enough
         if (buff_size < size_left) {
             using rvalue_reference = std::decay_t<rvalue_reference_t<BidirectionalIterator>>;
-            auto new_buffer = std::get_temporary_buffer<rvalue_reference>(size_left);
-            buffer.reset(new_buffer.first);
+            buffer.reset();
+            auto new_buffer = get_temporary_buffer<rvalue_reference>(resource, size_left);
+            buffer = std::move(new_buffer.first);
             buff_size = new_buffer.second;
         }
 
@@ -171,6 +176,7 @@ namespace detail
     auto merge_sort(ForwardIterator first, ForwardIterator,
                     difference_type_t<ForwardIterator> size,
                     Compare compare, Projection projection,
+                    utility::memory_resource* resource,
                     std::forward_iterator_tag)
         -> void
     {
@@ -183,7 +189,7 @@ namespace detail
         buffer_ptr<rvalue_reference_t<ForwardIterator>> buffer(nullptr);
         std::ptrdiff_t buffer_size = 0;
         merge_sort_impl(std::move(first), size,
-                        std::move(buffer), buffer_size,
+                        std::move(buffer), buffer_size, resource,
                         std::move(compare), std::move(projection));
     }
 
@@ -191,6 +197,7 @@ namespace detail
     auto merge_sort(BidirectionalIterator first, BidirectionalIterator last,
                     difference_type_t<BidirectionalIterator> size,
                     Compare compare, Projection projection,
+                    utility::memory_resource* resource,
                     std::bidirectional_iterator_tag)
         -> void
     {
@@ -203,20 +210,21 @@ namespace detail
         buffer_ptr<rvalue_reference_t<BidirectionalIterator>> buffer(nullptr);
         std::ptrdiff_t buffer_size = 0;
         merge_sort_impl(std::move(first), std::move(last), size,
-                        std::move(buffer), buffer_size,
+                        std::move(buffer), buffer_size, resource,
                         std::move(compare), std::move(projection));
     }
 
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto merge_sort(ForwardIterator first, ForwardIterator last,
                     difference_type_t<ForwardIterator> size,
-                    Compare compare, Projection projection)
+                    Compare compare, Projection projection,
+                    utility::memory_resource* resource=nullptr)
         -> void
     {
         using category = iterator_category_t<ForwardIterator>;
         merge_sort(std::move(first), std::move(last), size,
                    std::move(compare), std::move(projection),
-                   category{});
+                   resource, category{});
     }
 }}
 
@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "counting_sort.h"
+#include "iterator_traits.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    enum { parallel_counting_sort_threshold = 65536 };
+
+    ////////////////////////////////////////////////////////////
+    // Parallel counting sort
+    //
+    // The collection is split in blocks: every thread finds the
+    // bounds of a block and whether it is sorted, then counts the
+    // values of the block in a private histogram. The histograms
+    // are summed, and every thread fills an equal part of the
+    // collection, starting from the value found by a binary
+    // search in the prefix sums of the counts
+    //
+    // The counts are indexed by the position of the values in the
+    // output, which is why the reverse sort uses max - value as
+    // an index instead of value - min
+
+    template<typename RandomAccessIterator, typename Compare>
+    auto parallel_counting_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using value_type = value_type_t<RandomAccessIterator>;
+        constexpr bool reverse = std::is_same<Compare, std::greater<>>::value;
+
+        auto size = last - first;
+        if (size < parallel_counting_sort_threshold) {
+            if (reverse) {
+                reverse_counting_sort(std::move(first), std::move(last));
+            } else {
+                counting_sort(std::move(first), std::move(last));
+            }
+            return;
+        }
+
+        task_group tasks;
+        std::size_t nb_blocks = std::min(tasks.concurrency(), std::size_t(size / 16384));
+        auto block_begin = [&](std::size_t block) {
+            return size * difference_type(block) / difference_type(nb_blocks);
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Find the bounds of every block
+
+        struct block_info
+        {
+            value_type min;
+            value_type max;
+            bool is_sorted;
+        };
+        std::vector<block_info> infos(nb_blocks);
+
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto it = first + block_begin(block);
+                auto end = first + block_begin(block + 1);
+                block_info info = { *it, *it, true };
+                for (++it ; it != end ; ++it) {
+                    auto value = *it;
+                    if (compare(value, *(it - 1))) info.is_sorted = false;
+                    if (value < info.min) info.min = value;
+                    if (info.max < value) info.max = value;
+                }
+                infos[block] = info;
+            });
+        }
+        tasks.wait();
+
+        bool is_sorted = infos[0].is_sorted;
+        value_type min = infos[0].min;
+        value_type max = infos[0].max;
+        for (std::size_t block = 1 ; block < nb_blocks ; ++block) {
+            const auto& info = infos[block];
+            auto block_first = first + block_begin(block);
+            is_sorted = is_sorted && info.is_sorted &&
+                        not compare(*block_first, *(block_first - 1));
+            min = std::min(min, info.min);
+            max = std::max(max, info.max);
+        }
+        if (is_sorted) return;
+
+        ////////////////////////////////////////////////////////////
+        // Count the values of every block
+
+        // Compute the range with unsigned arithmetic: max - min can
+        // overflow the value type
+        using unsigned_t = counting_sort_unsigned_t<value_type>;
+        std::uintmax_t range = unsigned_t(unsigned_t(max) - unsigned_t(min));
+        if (range >= std::uintmax_t(size / difference_type(nb_blocks))) {
+            // The private histograms would take more memory than the
+            // collection, the serial algorithm counts everything at
+            // once or falls back to a radix sort for sparse ranges
+            if (reverse) {
+                reverse_counting_sort(std::move(first), std::move(last));
+            } else {
+                counting_sort(std::move(first), std::move(last));
+            }
+            return;
+        }
+        auto nb_values = difference_type(range) + 1;
+
+        auto index_of = [&](value_type value) {
+            return difference_type(reverse ? unsigned_t(unsigned_t(max) - unsigned_t(value))
+                                           : unsigned_t(unsigned_t(value) - unsigned_t(min)));
+        };
+        auto value_at = [&](difference_type index) {
+            return value_type(reverse ? unsigned_t(unsigned_t(max) - unsigned_t(index))
+                                      : unsigned_t(unsigned_t(min) + unsigned_t(index)));
+        };
+
+        std::vector<std::vector<difference_type>> block_counts(nb_blocks);
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto& counts = block_counts[block];
+                counts.assign(nb_values, 0);
+                auto end = first + block_begin(block + 1);
+                for (auto it = first + block_begin(block) ; it != end ; ++it) {
+                    ++counts[index_of(*it)];
+                }
+            });
+        }
+        tasks.wait();
+
+        // Position of the first occurrence of every value in the
+        // sorted collection, the last element is the size
+        std::vector<difference_type> starts(nb_values + 1);
+        difference_type total = 0;
+        for (difference_type index = 0 ; index < nb_values ; ++index) {
+            starts[index] = total;
+            for (const auto& counts: block_counts) {
+                total += counts[index];
+            }
+        }
+        starts[nb_values] = total;
+        block_counts.clear();
+
+        ////////////////////////////////////////////////////////////
+        // Fill equal parts of the collection
+
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto pos = block_begin(block);
+                auto end = block_begin(block + 1);
+                // Last value whose first occurrence is before pos
+                auto index = std::upper_bound(starts.begin(), starts.end(), pos)
+                           - starts.begin() - 1;
+                while (pos != end) {
+                    auto next = std::min(starts[index + 1], end);
+                    std::fill(first + pos, first + next, value_at(index));
+                    pos = next;
+                    ++index;
+                }
+            });
+        }
+        tasks.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
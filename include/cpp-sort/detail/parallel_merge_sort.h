@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "merge_sort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    enum { parallel_merge_sort_threshold = 16384 };
+
+    // Number of elements taken from the first sorted range when
+    // producing the first k elements of the stable merge of both
+    // ranges; it is the point where the merge path crosses the
+    // k-th anti-diagonal of the merge matrix
+    template<typename Iterator1, typename Iterator2, typename Compare, typename Projection>
+    auto merge_path_corank(Iterator1 first1, difference_type_t<Iterator1> size1,
+                           Iterator2 first2, difference_type_t<Iterator1> size2,
+                           difference_type_t<Iterator1> k,
+                           Compare compare, Projection projection)
+        -> difference_type_t<Iterator1>
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto low = std::max(k - size2, decltype(k)(0));
+        auto high = std::min(k, size1);
+        while (low < high) {
+            auto mid = low + (high - low) / 2;
+            // Equivalent elements of the first range come first
+            if (comp(proj(first2[k - mid - 1]), proj(first1[mid]))) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator,
+             typename Compare, typename Projection>
+    auto move_merge(InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2, InputIterator2 last2,
+                    OutputIterator result, Compare compare, Projection projection)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        while (first1 != last1 && first2 != last2) {
+            if (comp(proj(*first2), proj(*first1))) {
+                *result = std::move(*first2);
+                ++first2;
+            } else {
+                *result = std::move(*first1);
+                ++first1;
+            }
+            ++result;
+        }
+        result = std::move(first1, last1, result);
+        std::move(first2, last2, result);
+    }
+
+    // Merges the pairs of consecutive runs of [first, first + size)
+    // into result, every merge being split into independent slices
+    // of roughly slice_size elements along the merge path
+    template<typename InputIterator, typename OutputIterator,
+             typename Compare, typename Projection>
+    auto parallel_merge_pass(task_group& tasks,
+                             InputIterator first, OutputIterator result,
+                             const difference_type_t<InputIterator>* runs,
+                             std::size_t nb_runs,
+                             difference_type_t<InputIterator> slice_size,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<InputIterator>;
+
+        for (std::size_t run = 0 ; run + 1 < nb_runs ; run += 2) {
+            auto first1 = first + runs[run];
+            auto size1 = runs[run + 1] - runs[run];
+            auto first2 = first + runs[run + 1];
+            auto size2 = runs[run + 2] - runs[run + 1];
+            auto out = result + runs[run];
+
+            auto size = size1 + size2;
+            auto nb_slices = std::max(size / slice_size, difference_type(1));
+            for (difference_type slice = 0 ; slice < nb_slices ; ++slice) {
+                difference_type k_begin = size * slice / nb_slices;
+                difference_type k_end = size * (slice + 1) / nb_slices;
+                tasks.run([=] {
+                    auto i_begin = merge_path_corank(first1, size1, first2, size2,
+                                                     k_begin, compare, projection);
+                    auto i_end = merge_path_corank(first1, size1, first2, size2,
+                                                   k_end, compare, projection);
+                    move_merge(first1 + i_begin, first1 + i_end,
+                               first2 + (k_begin - i_begin), first2 + (k_end - i_end),
+                               out + k_begin, compare, projection);
+                });
+            }
+        }
+        tasks.wait();
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+
+        auto size = std::distance(first, last);
+        if (size < parallel_merge_sort_threshold) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        auto buffer = std::get_temporary_buffer<value_type>(size);
+        buffer_ptr<value_type> buffer_guard(buffer.first);
+        if (buffer.second < size) {
+            // Not enough memory to merge out-of-place, the serial
+            // merge_sort is able to cope with smaller buffers
+            buffer_guard.reset();
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        task_group tasks;
+
+        // The chunks are sorted into the buffer then the runs are merged
+        // back and forth between the buffer and the original range: use
+        // an odd number of merge passes so that the result always ends
+        // up in the original range
+        std::size_t nb_chunks = 2;
+        while (nb_chunks < tasks.concurrency() &&
+               size / difference_type(nb_chunks * 4) >= parallel_merge_sort_threshold / 8) {
+            nb_chunks *= 4;
+        }
+
+        std::unique_ptr<difference_type[]> runs(new difference_type[nb_chunks + 1]);
+        for (std::size_t chunk = 0 ; chunk <= nb_chunks ; ++chunk) {
+            runs[chunk] = size * difference_type(chunk) / difference_type(nb_chunks);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Sort the chunks concurrently and move them to the buffer
+
+        // Chunks are moved to the buffer independently, remember which
+        // ones were so that we know what to destroy when a comparison
+        // throws before every chunk has been sorted
+        std::unique_ptr<bool[]> initialized(new bool[nb_chunks]());
+        auto destroy_buffer = [&] {
+            for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                if (initialized[chunk]) {
+                    // The run boundaries are overwritten by the merge passes
+                    auto chunk_begin = size * difference_type(chunk) / difference_type(nb_chunks);
+                    auto chunk_end = size * difference_type(chunk + 1) / difference_type(nb_chunks);
+                    destruct_n<value_type> d(chunk_end - chunk_begin);
+                    d(buffer.first + chunk_begin);
+                }
+            }
+        };
+
+        try {
+            for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                tasks.run([&, chunk] {
+                    auto chunk_first = first + runs[chunk];
+                    auto chunk_last = first + runs[chunk + 1];
+                    merge_sort(chunk_first, chunk_last, runs[chunk + 1] - runs[chunk],
+                               compare, projection);
+                    std::uninitialized_copy(std::make_move_iterator(chunk_first),
+                                            std::make_move_iterator(chunk_last),
+                                            buffer.first + runs[chunk]);
+                    initialized[chunk] = true;
+                });
+            }
+            tasks.wait();
+
+            ////////////////////////////////////////////////////////////
+            // Merge the runs pairwise until there is only one left
+
+            // Slices small enough to keep every thread busy during the
+            // last passes, but still big enough to amortize the cost of
+            // the co-ranking binary searches
+            auto slice_size = std::max(size / difference_type(tasks.concurrency() * 4),
+                                       difference_type(parallel_merge_sort_threshold / 4));
+
+            bool from_buffer = true;
+            for (auto nb_runs = nb_chunks ; nb_runs > 1 ; nb_runs /= 2) {
+                if (from_buffer) {
+                    parallel_merge_pass(tasks, buffer.first, first, runs.get(), nb_runs,
+                                        slice_size, compare, projection);
+                } else {
+                    parallel_merge_pass(tasks, first, buffer.first, runs.get(), nb_runs,
+                                        slice_size, compare, projection);
+                }
+                from_buffer = not from_buffer;
+
+                // Forget about the boundaries that were merged away
+                for (std::size_t run = 1 ; run <= nb_runs / 2 ; ++run) {
+                    runs[run] = runs[run * 2];
+                }
+            }
+        } catch (...) {
+            destroy_buffer();
+            throw;
+        }
+        destroy_buffer();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
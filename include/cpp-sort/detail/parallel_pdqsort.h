@@ -0,0 +1,148 @@
+/*
+    parallel_pdqsort.h - Parallel pattern-defeating quicksort.
+
+    Copyright (c) 2015-2017 Orson Peters
+    Parallel version written in 2017 by Morwenn for cpp-sort
+
+    This software is provided 'as-is', without any express or implied warranty. In no event will the
+    authors be held liable for any damages arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose, including commercial
+    applications, and to alter it and redistribute it freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+       original software. If you use this software in a product, an acknowledgment in the product
+       documentation would be appreciated but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+       being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <iterator>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include "bitops.h"
+#include "heap_operations.h"
+#include "iterator_traits.h"
+#include "pdqsort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace pdqsort_detail {
+        enum {
+            // Partitions below this size are sorted sequentially.
+            parallel_sort_threshold = 16384
+        };
+
+        // Same algorithm as pdqsort_loop, except that left partitions big enough are sorted in
+        // tasks of the given task group while the current thread keeps partitioning the right
+        // ones. Sequential pdqsort_loop takes over once a partition gets small enough.
+        template<typename RandomAccessIterator, typename Compare, typename Projection,
+                 bool Branchless>
+        auto parallel_pdqsort_loop(task_group& tasks,
+                                   RandomAccessIterator begin, RandomAccessIterator end,
+                                   Compare compare, Projection projection,
+                                   int bad_allowed, bool leftmost=true)
+            -> void
+        {
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            while (true) {
+                difference_type size = std::distance(begin, end);
+
+                if (size < parallel_sort_threshold) {
+                    pdqsort_loop<RandomAccessIterator, Compare, Projection, Branchless>(
+                        begin, end, std::move(compare), std::move(projection), bad_allowed, leftmost);
+                    return;
+                }
+
+                choose_pivot(begin, end, size, compare, projection);
+
+                if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    begin = partition_left(begin, end, compare, projection) + 1;
+                    continue;
+                }
+
+                std::pair<RandomAccessIterator, bool> part_result =
+                    partition_right_dispatch<Branchless>(begin, end, compare, projection);
+                RandomAccessIterator pivot_pos = part_result.first;
+                bool already_partitioned = part_result.second;
+
+                difference_type l_size = std::distance(begin, pivot_pos);
+                difference_type r_size = std::distance(pivot_pos + 1, end);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                if (highly_unbalanced) {
+                    if (--bad_allowed == 0) {
+                        make_heap(begin, end, compare, projection);
+                        sort_heap(begin, end, std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    break_patterns(begin, pivot_pos, end);
+                } else {
+                    if (already_partitioned &&
+                        partial_insertion_sort(begin, pivot_pos, compare, projection) &&
+                        unguarded_partial_insertion_sort(pivot_pos + 1, end, compare, projection)) {
+                        return;
+                    }
+                }
+
+                // The partitions never overlap and the pivot between them doesn't move anymore,
+                // which means that they can be sorted concurrently: give the left one away to
+                // any available thread unless it's too small to be worth it.
+                if (l_size < parallel_sort_threshold) {
+                    pdqsort_loop<RandomAccessIterator, Compare, Projection, Branchless>(
+                        begin, pivot_pos, compare, projection, bad_allowed, leftmost);
+                } else {
+                    tasks.run([&tasks, begin, pivot_pos, compare, projection, bad_allowed, leftmost] {
+                        parallel_pdqsort_loop<RandomAccessIterator, Compare, Projection, Branchless>(
+                            tasks, begin, pivot_pos, compare, projection, bad_allowed, leftmost);
+                    });
+                }
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_pdqsort(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection)
+        -> void
+    {
+        using value_type = decltype(*begin);
+        using projected_type = decltype(utility::as_function(projection)(*begin));
+        constexpr bool is_branchless =
+            utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+            utility::is_probably_branchless_projection_v<Projection, value_type>;
+
+        auto size = std::distance(begin, end);
+        if (size < pdqsort_detail::parallel_sort_threshold) {
+            pdqsort(std::move(begin), std::move(end), std::move(compare), std::move(projection));
+            return;
+        }
+
+        task_group tasks;
+        pdqsort_detail::parallel_pdqsort_loop<RandomAccessIterator, Compare, Projection, is_branchless>(
+            tasks, std::move(begin), std::move(end),
+            std::move(compare), std::move(projection),
+            detail::log2(size));
+        tasks.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
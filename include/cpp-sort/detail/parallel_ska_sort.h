@@ -0,0 +1,304 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "ska_sort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    enum { parallel_ska_sort_threshold = 65536 };
+
+    ////////////////////////////////////////////////////////////
+    // Parallel radix pass
+    //
+    // Distributes the elements according to one byte of an unsigned
+    // sub-key: every thread computes the histogram of a block of the
+    // collection, which gives each block its own write offsets in
+    // every bucket, then the blocks are scattered concurrently to a
+    // buffer. The buckets are moved back, then sorted independently
+    // once the buffer is released, the biggest ones with another
+    // parallel pass on the next byte
+
+    template<typename CurrentSubKey, std::size_t NumBytes, std::size_t Offset=0>
+    struct parallel_radix_sorter
+    {
+        using serial_sorter = UnsignedInplaceSorter<128, 1024, CurrentSubKey, NumBytes, Offset>;
+
+        template<typename RandomAccessIterator, typename Projection>
+        static auto sort(RandomAccessIterator begin, RandomAccessIterator end,
+                         std::ptrdiff_t num_elements, Projection projection,
+                         void (*next_sort)(RandomAccessIterator, RandomAccessIterator, std::ptrdiff_t, Projection, void*))
+            -> void
+        {
+            using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+
+            if (StdSortIfLessThanThreshold<128>(begin, end, num_elements, projection)) {
+                return;
+            }
+            if (num_elements < parallel_ska_sort_threshold) {
+                serial_sorter::sort(std::move(begin), std::move(end), num_elements,
+                                    std::move(projection), next_sort, nullptr);
+                return;
+            }
+
+            auto&& proj = utility::as_function(projection);
+            task_group tasks;
+
+            ////////////////////////////////////////////////////////////
+            // Compute the histogram of every block
+
+            std::size_t nb_blocks = std::min(tasks.concurrency(),
+                                             std::size_t(num_elements / 4096));
+            std::vector<std::array<std::size_t, 256>> counts(nb_blocks);
+            auto block_begin = [&](std::size_t block) {
+                return num_elements * std::ptrdiff_t(block) / std::ptrdiff_t(nb_blocks);
+            };
+
+            // Remember the current byte of every element so that the
+            // sub-keys aren't computed twice
+            std::unique_ptr<std::uint8_t[]> bytes(new std::uint8_t[num_elements]);
+
+            for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+                tasks.run([&, block] {
+                    auto& block_counts = counts[block];
+                    block_counts.fill(0);
+                    for (auto i = block_begin(block) ; i != block_begin(block + 1) ; ++i) {
+                        auto byte = serial_sorter::current_byte(proj(begin[i]), nullptr);
+                        bytes[i] = byte;
+                        ++block_counts[byte];
+                    }
+                });
+            }
+            tasks.wait();
+
+            ////////////////////////////////////////////////////////////
+            // Prefix sums: offsets of the blocks in every bucket
+
+            // There are only 256 * nb_blocks counters, which is too
+            // small to be worth computing the prefix sums in parallel
+            std::array<std::size_t, 257> buckets;
+            std::size_t total = 0;
+            for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                buckets[bucket] = total;
+                for (auto& block_counts: counts) {
+                    auto count = block_counts[bucket];
+                    block_counts[bucket] = total;
+                    total += count;
+                }
+            }
+            buckets[256] = total;
+
+            // Everything is in the same bucket, skip to the next byte
+            for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                if (buckets[bucket + 1] - buckets[bucket] == std::size_t(num_elements)) {
+                    bytes.reset();
+                    parallel_radix_sorter<CurrentSubKey, NumBytes, Offset + 1>::sort(
+                        std::move(begin), std::move(end), num_elements,
+                        std::move(projection), next_sort);
+                    return;
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Scatter the blocks to the buffer
+
+            auto buffer = std::get_temporary_buffer<value_type>(num_elements);
+            std::unique_ptr<value_type, temporary_buffer_deleter> buffer_guard(buffer.first);
+            if (buffer.second < num_elements) {
+                // Not enough memory, distribute the elements in-place
+                bytes.reset();
+                buffer_guard.reset();
+                serial_sorter::sort(std::move(begin), std::move(end), num_elements,
+                                    std::move(projection), next_sort, nullptr);
+                return;
+            }
+
+            // Moves can't throw, which means that the buffer is always
+            // entirely filled once the scattering tasks are done
+            for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+                tasks.run([&, block] {
+                    auto& offsets = counts[block];
+                    for (auto i = block_begin(block) ; i != block_begin(block + 1) ; ++i) {
+                        ::new(buffer.first + offsets[bytes[i]]++) value_type(std::move(begin[i]));
+                    }
+                });
+            }
+            tasks.wait();
+            bytes.reset();
+
+            ////////////////////////////////////////////////////////////
+            // Move the buckets back
+
+            // Every bucket is moved back and the buffer is released
+            // before sorting the buckets, otherwise the buffers of the
+            // recursive passes would pile up on top of this one
+            for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+                tasks.run([&, block] {
+                    auto first = block_begin(block);
+                    auto last = block_begin(block + 1);
+                    std::move(buffer.first + first, buffer.first + last, begin + first);
+                    destruct_n<value_type> d(last - first);
+                    d(buffer.first + first);
+                });
+            }
+            tasks.wait();
+            buffer_guard.reset();
+
+            ////////////////////////////////////////////////////////////
+            // Sort the buckets
+
+            if (Offset + 1 == NumBytes && not next_sort) {
+                return;
+            }
+            for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                std::ptrdiff_t bucket_begin = buckets[bucket];
+                std::ptrdiff_t bucket_end = buckets[bucket + 1];
+                if (bucket_begin == bucket_end) continue;
+
+                tasks.run([=] {
+                    parallel_radix_sorter<CurrentSubKey, NumBytes, Offset + 1>::sort(
+                        begin + bucket_begin, begin + bucket_end, bucket_end - bucket_begin,
+                        projection, next_sort);
+                });
+            }
+            tasks.wait();
+        }
+    };
+
+    template<typename CurrentSubKey, std::size_t NumBytes>
+    struct parallel_radix_sorter<CurrentSubKey, NumBytes, NumBytes>
+    {
+        template<typename RandomAccessIterator, typename Projection>
+        static auto sort(RandomAccessIterator begin, RandomAccessIterator end,
+                         std::ptrdiff_t num_elements, Projection projection,
+                         void (*next_sort)(RandomAccessIterator, RandomAccessIterator, std::ptrdiff_t, Projection, void*))
+            -> void
+        {
+            // The following sub-keys are sorted serially
+            if (next_sort) {
+                next_sort(std::move(begin), std::move(end), num_elements,
+                          std::move(projection), nullptr);
+            }
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Entry point
+
+    template<typename CurrentSubKey, typename SubKeyType=typename CurrentSubKey::sub_key_type>
+    struct parallel_sort_starter
+    {
+        // Only unsigned integer sub-keys are distributed in parallel,
+        // booleans and lists use the serial algorithm
+        template<typename RandomAccessIterator, typename Projection>
+        static auto sort(RandomAccessIterator begin, RandomAccessIterator end,
+                         Projection projection)
+            -> void
+        {
+            ska_sort(std::move(begin), std::move(end), std::move(projection));
+        }
+    };
+
+    template<typename CurrentSubKey, typename SubKeyType>
+    struct unsigned_parallel_sort_starter
+    {
+        template<typename RandomAccessIterator, typename Projection>
+        static auto sort(RandomAccessIterator begin, RandomAccessIterator end,
+                         Projection projection)
+            -> void
+        {
+            using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+            constexpr bool can_scatter =
+                std::is_nothrow_move_constructible<value_type>::value &&
+                std::is_nothrow_move_assignable<value_type>::value;
+
+            auto size = end - begin;
+            if (not can_scatter || size < parallel_ska_sort_threshold) {
+                ska_sort(std::move(begin), std::move(end), std::move(projection));
+                return;
+            }
+
+            using SortType = void (*)(RandomAccessIterator, RandomAccessIterator, std::ptrdiff_t, Projection, void*);
+            SortType next_sort = static_cast<SortType>(&SortStarter<128, 1024, typename CurrentSubKey::next>::sort);
+            if (next_sort == static_cast<SortType>(&SortStarter<128, 1024, SubKey<void>>::sort)) {
+                next_sort = nullptr;
+            }
+            parallel_radix_sorter<CurrentSubKey, sizeof(SubKeyType)>::sort(
+                std::move(begin), std::move(end), size,
+                std::move(projection), next_sort);
+        }
+    };
+
+    template<typename CurrentSubKey>
+    struct parallel_sort_starter<CurrentSubKey, std::uint8_t>:
+        unsigned_parallel_sort_starter<CurrentSubKey, std::uint8_t>
+    {};
+
+    template<typename CurrentSubKey>
+    struct parallel_sort_starter<CurrentSubKey, std::uint16_t>:
+        unsigned_parallel_sort_starter<CurrentSubKey, std::uint16_t>
+    {};
+
+    template<typename CurrentSubKey>
+    struct parallel_sort_starter<CurrentSubKey, std::uint32_t>:
+        unsigned_parallel_sort_starter<CurrentSubKey, std::uint32_t>
+    {};
+
+    template<typename CurrentSubKey>
+    struct parallel_sort_starter<CurrentSubKey, std::uint64_t>:
+        unsigned_parallel_sort_starter<CurrentSubKey, std::uint64_t>
+    {};
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto parallel_ska_sort(RandomAccessIterator begin, RandomAccessIterator end,
+                           Projection projection)
+        -> void
+    {
+        using SubKey = SubKey<decltype(utility::as_function(projection)(*begin))>;
+        parallel_sort_starter<SubKey>::sort(std::move(begin), std::move(end),
+                                            std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
@@ -0,0 +1,303 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_STRING_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_STRING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "pdqsort.h"
+#include "spreadsort/string_sort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    enum { parallel_string_sort_threshold = 65536 };
+
+    ////////////////////////////////////////////////////////////
+    // Serial recursion
+    //
+    // Sorts strings sharing their first char_offset characters
+    // with the recursion of string_sort
+
+    template<typename Unsigned_char_type, bool Reverse,
+             typename RandomAccessIterator, typename Projection>
+    auto serial_string_sort_rec(RandomAccessIterator first, RandomAccessIterator last,
+                                std::size_t char_offset, Projection projection)
+        -> void
+    {
+        constexpr std::size_t bin_count = std::size_t(1) << (8 * sizeof(Unsigned_char_type));
+
+        auto size = std::size_t(last - first);
+        if (size < 2) return;
+
+        if (size < bin_count) {
+            if (Reverse) {
+                pdqsort(std::move(first), std::move(last),
+                        spreadsort::detail::offset_greater_than<Projection, Unsigned_char_type>(
+                            char_offset, std::move(projection)),
+                        utility::identity{});
+            } else {
+                pdqsort(std::move(first), std::move(last),
+                        spreadsort::detail::offset_less_than<Projection, Unsigned_char_type>(
+                            char_offset, std::move(projection)),
+                        utility::identity{});
+            }
+            return;
+        }
+
+        std::size_t bin_sizes[bin_count + 1];
+        std::vector<RandomAccessIterator> bin_cache;
+        if (Reverse) {
+            spreadsort::detail::reverse_string_sort_rec<Unsigned_char_type>(
+                std::move(first), std::move(last), char_offset,
+                bin_cache, 0, bin_sizes, std::move(projection));
+        } else {
+            spreadsort::detail::string_sort_rec<Unsigned_char_type>(
+                std::move(first), std::move(last), char_offset,
+                bin_cache, 0, bin_sizes, std::move(projection));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel MSD pass
+    //
+    // Distributes the strings according to their character at
+    // char_offset like parallel_ska_sort distributes integers:
+    // every block of the collection gets its own histogram and
+    // write offsets, the blocks are scattered concurrently to a
+    // buffer, then every bucket is moved back and sorted as an
+    // independent task, the biggest ones with another parallel
+    // pass on the next character
+
+    template<typename Unsigned_char_type, bool Reverse,
+             typename RandomAccessIterator, typename Projection>
+    auto parallel_string_sort_rec(RandomAccessIterator first, RandomAccessIterator last,
+                                  std::size_t char_offset, Projection projection)
+        -> void
+    {
+        using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+        // Empty strings get their own bucket, first or last
+        // depending on the order of the sort
+        using bucket_type = std::conditional_t<
+            sizeof(Unsigned_char_type) == 1,
+            std::uint16_t,
+            std::uint32_t
+        >;
+        constexpr std::size_t bin_count = std::size_t(1) << (8 * sizeof(Unsigned_char_type));
+        constexpr std::size_t nb_buckets = bin_count + 1;
+
+        auto num_elements = last - first;
+        if (num_elements < parallel_string_sort_threshold) {
+            serial_string_sort_rec<Unsigned_char_type, Reverse>(
+                std::move(first), std::move(last), char_offset, std::move(projection));
+            return;
+        }
+
+        auto&& proj = utility::as_function(projection);
+
+        // Skip the characters shared by every string, which is
+        // common for keys such as paths or timestamps; strings too
+        // short to reach char_offset are all equal
+        auto non_empty = first;
+        while (proj(*non_empty).size() <= char_offset) {
+            if (++non_empty == last) return;
+        }
+        spreadsort::detail::update_offset<Unsigned_char_type>(non_empty, last, char_offset, projection);
+
+        auto bucket_of = [&](const auto& str) -> bucket_type {
+            if (str.size() <= char_offset) {
+                return Reverse ? bin_count : 0;
+            }
+            auto character = static_cast<Unsigned_char_type>(str[char_offset]);
+            return Reverse ? (bin_count - 1) - character : character + 1;
+        };
+
+        task_group tasks;
+
+        ////////////////////////////////////////////////////////////
+        // Compute the histogram of every block
+
+        std::size_t nb_blocks = std::min(tasks.concurrency(),
+                                         std::size_t(num_elements / 4096));
+        std::vector<std::vector<std::size_t>> counts(nb_blocks);
+        auto block_begin = [&](std::size_t block) {
+            return num_elements * std::ptrdiff_t(block) / std::ptrdiff_t(nb_blocks);
+        };
+
+        // Remember the bucket of every element so that the strings
+        // aren't read twice, which would mean twice the cache misses
+        std::unique_ptr<bucket_type[]> buckets_of(new bucket_type[num_elements]);
+
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto& block_counts = counts[block];
+                block_counts.assign(nb_buckets, 0);
+                for (auto i = block_begin(block) ; i != block_begin(block + 1) ; ++i) {
+                    auto bucket = bucket_of(proj(first[i]));
+                    buckets_of[i] = bucket;
+                    ++block_counts[bucket];
+                }
+            });
+        }
+        tasks.wait();
+
+        ////////////////////////////////////////////////////////////
+        // Prefix sums: offsets of the blocks in every bucket
+
+        std::vector<std::size_t> buckets(nb_buckets + 1);
+        std::size_t total = 0;
+        for (std::size_t bucket = 0 ; bucket < nb_buckets ; ++bucket) {
+            buckets[bucket] = total;
+            for (auto& block_counts: counts) {
+                auto count = block_counts[bucket];
+                block_counts[bucket] = total;
+                total += count;
+            }
+        }
+        buckets[nb_buckets] = total;
+
+        ////////////////////////////////////////////////////////////
+        // Scatter the blocks to the buffer
+
+        auto buffer = std::get_temporary_buffer<value_type>(num_elements);
+        std::unique_ptr<value_type, temporary_buffer_deleter> buffer_guard(buffer.first);
+        if (buffer.second < num_elements) {
+            // Not enough memory, sort everything serially in-place
+            buckets_of.reset();
+            buffer_guard.reset();
+            serial_string_sort_rec<Unsigned_char_type, Reverse>(
+                std::move(first), std::move(last), char_offset, std::move(projection));
+            return;
+        }
+
+        // Moves can't throw, which means that the buffer is always
+        // entirely filled once the scattering tasks are done
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto& offsets = counts[block];
+                for (auto i = block_begin(block) ; i != block_begin(block + 1) ; ++i) {
+                    ::new(buffer.first + offsets[buckets_of[i]]++) value_type(std::move(first[i]));
+                }
+            });
+        }
+        tasks.wait();
+        buckets_of.reset();
+
+        ////////////////////////////////////////////////////////////
+        // Move the buckets back
+
+        // Every bucket is moved back and the buffer is released
+        // before sorting the buckets, otherwise the buffers of the
+        // recursive calls would pile up on top of this one
+        for (std::size_t block = 0 ; block < nb_blocks ; ++block) {
+            tasks.run([&, block] {
+                auto block_first = block_begin(block);
+                auto block_last = block_begin(block + 1);
+                std::move(buffer.first + block_first, buffer.first + block_last, first + block_first);
+                destruct_n<value_type> d(block_last - block_first);
+                d(buffer.first + block_first);
+            });
+        }
+        tasks.wait();
+        buffer_guard.reset();
+        std::vector<std::vector<std::size_t>>().swap(counts);
+
+        ////////////////////////////////////////////////////////////
+        // Sort the buckets
+
+        std::size_t empty_bucket = Reverse ? bin_count : 0;
+        for (std::size_t bucket = 0 ; bucket < nb_buckets ; ++bucket) {
+            std::ptrdiff_t bucket_begin = buckets[bucket];
+            std::ptrdiff_t bucket_end = buckets[bucket + 1];
+            // The strings ending before char_offset are all equal
+            if (bucket_begin == bucket_end || bucket == empty_bucket) continue;
+
+            tasks.run([=] {
+                parallel_string_sort_rec<Unsigned_char_type, Reverse>(
+                    first + bucket_begin, first + bucket_end, char_offset + 1, projection);
+            });
+        }
+        tasks.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Entry points
+
+    template<typename RandomAccessIterator, typename Projection, typename Unsigned_char_type>
+    auto parallel_string_sort(RandomAccessIterator first, RandomAccessIterator last,
+                              Projection projection, Unsigned_char_type unused)
+        -> void
+    {
+        using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+        constexpr bool can_scatter =
+            std::is_nothrow_move_constructible<value_type>::value &&
+            std::is_nothrow_move_assignable<value_type>::value;
+
+        if (not can_scatter || last - first < parallel_string_sort_threshold) {
+            spreadsort::string_sort(std::move(first), std::move(last),
+                                    std::move(projection), unused);
+            return;
+        }
+        parallel_string_sort_rec<Unsigned_char_type, false>(
+            std::move(first), std::move(last), 0, std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Projection, typename Unsigned_char_type>
+    auto parallel_reverse_string_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                      Projection projection, Unsigned_char_type unused)
+        -> void
+    {
+        using value_type = std::decay_t<rvalue_reference_t<RandomAccessIterator>>;
+        constexpr bool can_scatter =
+            std::is_nothrow_move_constructible<value_type>::value &&
+            std::is_nothrow_move_assignable<value_type>::value;
+
+        if (not can_scatter || last - first < parallel_string_sort_threshold) {
+            spreadsort::reverse_string_sort(std::move(first), std::move(last),
+                                            std::greater<>{}, std::move(projection), unused);
+            return;
+        }
+        parallel_string_sort_rec<Unsigned_char_type, true>(
+            std::move(first), std::move(last), 0, std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_STRING_SORT_H_
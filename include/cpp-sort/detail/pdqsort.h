@@ -29,6 +29,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/branchless_traits.h>
@@ -38,6 +40,8 @@
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "iter_sort3.h"
+#include "simd_bitonic_sort.h"
+#include "simd_partition.h"
 
 namespace cppsort
 {
@@ -457,6 +461,128 @@ namespace detail
             return pivot_pos;
         }
 
+        // Same as partition_right_branchless, but partitions whole SIMD registers at once
+        // instead of going through blocks of offsets. Only used for contiguous collections
+        // of arithmetic types without projection.
+        template<typename RandomAccessIterator, typename Compare>
+        auto partition_right_simd(RandomAccessIterator begin, RandomAccessIterator end,
+                                  Compare compare)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            auto&& comp = utility::as_function(compare);
+
+            auto pivot = *begin;
+            RandomAccessIterator first = begin;
+            RandomAccessIterator last = end;
+
+            // Find the first element greater than or equal than the pivot (the median of 3 guarantees
+            // this exists).
+            while (comp(*++first, pivot));
+
+            // Find the first element strictly smaller than the pivot. We have to guard this search if
+            // there was no element before *first.
+            if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+            else                    while (                !comp(*--last, pivot));
+
+            // If the first pair of elements that should be swapped to partition are the same element,
+            // the passed in sequence already was correctly partitioned.
+            bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                auto ptr = std::addressof(*first);
+                first += simd_partition(ptr, std::addressof(*last) + 1, pivot, compare) - ptr;
+            }
+
+            // Put the pivot in the right place.
+            RandomAccessIterator pivot_pos = first - 1;
+            *begin = *pivot_pos;
+            *pivot_pos = pivot;
+
+            return std::make_pair(pivot_pos, already_partitioned);
+        }
+
+        // Picks the best partitioning algorithm available for the given parameters.
+        template<bool Branchless, typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_dispatch(RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection)
+            -> std::enable_if_t<
+                is_simd_partitionable_iterator_v<RandomAccessIterator, Compare, Projection>,
+                std::pair<RandomAccessIterator, bool>
+            >
+        {
+            return partition_right_simd(begin, end, compare);
+        }
+
+        template<bool Branchless, typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_dispatch(RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection projection)
+            -> std::enable_if_t<
+                not is_simd_partitionable_iterator_v<RandomAccessIterator, Compare, Projection>,
+                std::pair<RandomAccessIterator, bool>
+            >
+        {
+            return Branchless ?
+                partition_right_branchless(begin, end, compare, projection) :
+                partition_right(begin, end, compare, projection);
+        }
+
+        // Chooses a pivot for [begin, end) as median of 3 or pseudomedian of 9 and puts
+        // it at the beginning of the sequence.
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto choose_pivot(RandomAccessIterator begin, RandomAccessIterator end,
+                          difference_type_t<RandomAccessIterator> size,
+                          Compare compare, Projection projection)
+            -> void
+        {
+            using utility::iter_swap;
+
+            auto s2 = size / 2;
+            if (size > ninther_threshold) {
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+            } else {
+                iter_sort3(begin + s2, begin, end - 1, std::move(compare), std::move(projection));
+            }
+        }
+
+        // Shuffles some elements of both partitions around the pivot at pivot_pos to
+        // break many patterns after a highly unbalanced partition.
+        template<typename RandomAccessIterator>
+        auto break_patterns(RandomAccessIterator begin, RandomAccessIterator pivot_pos,
+                            RandomAccessIterator end)
+            -> void
+        {
+            using utility::iter_swap;
+
+            auto l_size = std::distance(begin, pivot_pos);
+            auto r_size = std::distance(pivot_pos + 1, end);
+
+            if (l_size >= insertion_sort_threshold) {
+                iter_swap(begin,             begin + l_size / 4);
+                iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > ninther_threshold) {
+                    iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                    iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                    iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= insertion_sort_threshold) {
+                iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                iter_swap(end - 1,                   end - r_size / 4);
+
+                if (r_size > ninther_threshold) {
+                    iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    iter_swap(end - 2,             end - (1 + r_size / 4));
+                    iter_swap(end - 3,             end - (2 + r_size / 4));
+                }
+            }
+        }
 
         template<typename RandomAccessIterator, typename Compare, typename Projection,
                  bool Branchless>
@@ -465,7 +591,6 @@ namespace detail
                           int bad_allowed, bool leftmost=true)
             -> void
         {
-            using utility::iter_swap;
             using difference_type = difference_type_t<RandomAccessIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
@@ -474,6 +599,11 @@ namespace detail
             while (true) {
                 difference_type size = std::distance(begin, end);
 
+                // SIMD sorting networks are even faster when they can be used.
+                if (simd_small_sort(begin, end, size, compare, projection)) {
+                    return;
+                }
+
                 // Insertion sort is faster for small arrays.
                 if (size < insertion_sort_threshold) {
                     if (leftmost) {
@@ -485,16 +615,7 @@ namespace detail
                 }
 
                 // Choose pivot as median of 3 or pseudomedian of 9.
-                difference_type s2 = size / 2;
-                if (size > ninther_threshold) {
-                    iter_sort3(begin, begin + s2, end - 1, compare, projection);
-                    iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
-                    iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
-                    iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
-                    iter_swap(begin, begin + s2);
-                } else {
-                    iter_sort3(begin + s2, begin, end - 1, compare, projection);
-                }
+                choose_pivot(begin, end, size, compare, projection);
 
                 // If *(begin - 1) is the end of the right partition of a previous partition operation
                 // there is no element in [begin, end) that is smaller than *(begin - 1). Then if our
@@ -507,9 +628,8 @@ namespace detail
                 }
 
                 // Partition and get results.
-                std::pair<RandomAccessIterator, bool> part_result = Branchless  ?
-                    partition_right_branchless(begin, end, compare, projection) :
-                    partition_right(begin, end, compare, projection);
+                std::pair<RandomAccessIterator, bool> part_result =
+                    partition_right_dispatch<Branchless>(begin, end, compare, projection);
                 RandomAccessIterator pivot_pos = part_result.first;
                 bool already_partitioned = part_result.second;
 
@@ -527,29 +647,7 @@ namespace detail
                         return;
                     }
 
-                    if (l_size >= insertion_sort_threshold) {
-                        iter_swap(begin,             begin + l_size / 4);
-                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
-
-                        if (l_size > ninther_threshold) {
-                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
-                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
-                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
-                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
-                        }
-                    }
-
-                    if (r_size >= insertion_sort_threshold) {
-                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
-                        iter_swap(end - 1,                   end - r_size / 4);
-
-                        if (r_size > ninther_threshold) {
-                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
-                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
-                            iter_swap(end - 2,             end - (1 + r_size / 4));
-                            iter_swap(end - 3,             end - (2 + r_size / 4));
-                        }
-                    }
+                    break_patterns(begin, pivot_pos, end);
                 } else {
                     // If we were decently balanced and we tried to sort an already partitioned
                     // sequence try to use insertion sort.
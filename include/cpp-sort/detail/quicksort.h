@@ -36,6 +36,7 @@
 #include "iterator_traits.h"
 #include "iter_sort3.h"
 #include "partition.h"
+#include "simd_bitonic_sort.h"
 
 namespace cppsort
 {
@@ -76,6 +77,22 @@ namespace detail
         return false;
     }
 
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto quicksort_fallback(RandomAccessIterator first, RandomAccessIterator last,
+                            difference_type_t<RandomAccessIterator> size,
+                            Compare compare, Projection projection,
+                            std::random_access_iterator_tag)
+        -> bool
+    {
+        if (simd_small_sort(first, last, size, compare, projection))
+        {
+            return true;
+        }
+        return quicksort_fallback(std::move(first), std::move(last), size,
+                                  std::move(compare), std::move(projection),
+                                  std::bidirectional_iterator_tag{});
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto quicksort(ForwardIterator first, ForwardIterator last,
                    difference_type_t<ForwardIterator> size,
@@ -0,0 +1,158 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SAMPLING_H_
+#define CPPSORT_DETAIL_SAMPLING_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "iterator_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Small pseudo-random number generator, good enough to
+    // pick sample positions and cheap to seed
+
+    class splitmix64
+    {
+        public:
+
+            explicit splitmix64(std::uint64_t seed) noexcept:
+                _state(seed)
+            {}
+
+            auto operator()() noexcept
+                -> std::uint64_t
+            {
+                std::uint64_t z = (_state += 0x9e3779b97f4a7c15u);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+                return z ^ (z >> 31);
+            }
+
+            // Returns a number in [0, bound), the modulo bias is
+            // negligible for the bounds used to sample collections
+            auto below(std::uint64_t bound) noexcept
+                -> std::uint64_t
+            {
+                return (*this)() % bound;
+            }
+
+        private:
+
+            std::uint64_t _state;
+    };
+
+    constexpr std::uint64_t default_sampling_seed = 0x5eed5eed5eed5eedu;
+
+    ////////////////////////////////////////////////////////////
+    // Sampling
+    //
+    // Return iterators to sample_size distinct elements of the
+    // collection, sample_size < size, in the order in which they
+    // appear in the collection
+
+    // Jittered systematic sample: one element picked at random in
+    // each of sample_size blocks of roughly equal size
+    template<typename RandomAccessIterator>
+    auto sample_iterators(RandomAccessIterator first, RandomAccessIterator,
+                          difference_type_t<RandomAccessIterator> size,
+                          difference_type_t<RandomAccessIterator> sample_size,
+                          splitmix64& random, std::random_access_iterator_tag)
+        -> std::vector<RandomAccessIterator>
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        std::vector<RandomAccessIterator> sample;
+        sample.reserve(sample_size);
+        difference_type block_begin = 0;
+        for (difference_type i = 1 ; i <= sample_size ; ++i) {
+            auto block_end = static_cast<difference_type>(
+                static_cast<std::uintmax_t>(size) * i / sample_size
+            );
+            auto offset = random.below(block_end - block_begin);
+            sample.push_back(first + (block_begin + static_cast<difference_type>(offset)));
+            block_begin = block_end;
+        }
+        return sample;
+    }
+
+    // Reservoir sampling in a single pass
+    template<typename ForwardIterator>
+    auto sample_iterators(ForwardIterator first, ForwardIterator last,
+                          difference_type_t<ForwardIterator>,
+                          difference_type_t<ForwardIterator> sample_size,
+                          splitmix64& random, std::forward_iterator_tag)
+        -> std::vector<ForwardIterator>
+    {
+        using difference_type = difference_type_t<ForwardIterator>;
+
+        std::vector<std::pair<difference_type, ForwardIterator>> reservoir;
+        reservoir.reserve(sample_size);
+        for (difference_type pos = 0 ; first != last ; ++first, ++pos) {
+            if (pos < sample_size) {
+                reservoir.emplace_back(pos, first);
+            } else {
+                auto index = random.below(pos + 1);
+                if (index < static_cast<std::uint64_t>(sample_size)) {
+                    reservoir[index] = { pos, first };
+                }
+            }
+        }
+
+        // Restore the order of the collection
+        std::sort(std::begin(reservoir), std::end(reservoir),
+                  [](const auto& lhs, const auto& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+        std::vector<ForwardIterator> sample;
+        sample.reserve(sample_size);
+        for (auto& elem: reservoir) {
+            sample.push_back(elem.second);
+        }
+        return sample;
+    }
+
+    template<typename ForwardIterator>
+    auto sample_iterators(ForwardIterator first, ForwardIterator last,
+                          difference_type_t<ForwardIterator> size,
+                          difference_type_t<ForwardIterator> sample_size,
+                          splitmix64& random)
+        -> std::vector<ForwardIterator>
+    {
+        return sample_iterators(std::move(first), std::move(last), size, sample_size,
+                                random, iterator_category_t<ForwardIterator>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SAMPLING_H_
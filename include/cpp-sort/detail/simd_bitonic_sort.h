@@ -0,0 +1,609 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SIMD_BITONIC_SORT_H_
+#define CPPSORT_DETAIL_SIMD_BITONIC_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#   include <immintrin.h>
+#elif defined(__SSE4_1__)
+#   include <smmintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // In-register bitonic sort
+    //
+    // Sorts up to 64 elements held in SIMD registers with a
+    // bitonic sorting network: exchanges between lanes of
+    // different registers are vertical min/max operations, while
+    // exchanges between lanes of the same register shuffle the
+    // register and blend the min and max back. The widest
+    // instruction set enabled at compile time among AVX-512F,
+    // AVX2 and SSE4.1 is used, and 32-bit integers and floats
+    // are supported. Floats are compared and blended instead of
+    // using min/max instructions, which would otherwise turn -0.0
+    // into 0.0 and get rid of NaNs
+
+    enum { simd_sort_max_size = 64 };
+
+    template<typename T>
+    struct simd_ops;
+
+    template<std::size_t N>
+    using simd_index = std::integral_constant<std::size_t, N>;
+
+#if defined(__AVX512F__)
+
+    struct simd_ops_base
+    {
+        static constexpr std::size_t width = 16;
+        using mask = __mmask16;
+
+        // Lanes whose index has any of the given bits set
+        static auto lane_bits(unsigned bits)
+            -> mask
+        {
+            unsigned res = 0;
+            for (unsigned lane = 0 ; lane < width ; ++lane) {
+                res |= unsigned((lane & bits) != 0) << lane;
+            }
+            return mask(res);
+        }
+
+        static auto uniform(bool value)
+            -> mask
+        {
+            return value ? mask(0xFFFF) : mask(0);
+        }
+
+        static auto mask_xor(mask lhs, mask rhs)
+            -> mask
+        {
+            return mask(lhs ^ rhs);
+        }
+    };
+
+    struct simd_ops_int_base:
+        simd_ops_base
+    {
+        using reg = __m512i;
+
+        static auto load(const void* ptr) -> reg { return _mm512_loadu_si512(ptr); }
+        static auto store(void* ptr, reg value) -> void { _mm512_storeu_si512(ptr, value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm512_mask_blend_epi32(m, lhs, rhs); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm512_shuffle_epi32(value, _MM_PERM_CDAB); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm512_shuffle_epi32(value, _MM_PERM_BADC); }
+        static auto permute_xor(reg value, simd_index<4>) -> reg { return _mm512_shuffle_i32x4(value, value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<8>) -> reg { return _mm512_shuffle_i32x4(value, value, 0x4E); }
+    };
+
+    template<>
+    struct simd_ops<std::int32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm512_min_epi32(lhs, rhs);
+            rhs = _mm512_max_epi32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<std::uint32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm512_min_epu32(lhs, rhs);
+            rhs = _mm512_max_epu32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<float>:
+        simd_ops_base
+    {
+        using reg = __m512;
+
+        static auto load(const void* ptr) -> reg { return _mm512_loadu_ps(ptr); }
+        static auto store(void* ptr, reg value) -> void { _mm512_storeu_ps(ptr, value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm512_mask_blend_ps(m, lhs, rhs); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm512_permute_ps(value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm512_permute_ps(value, 0x4E); }
+        static auto permute_xor(reg value, simd_index<4>) -> reg { return _mm512_shuffle_f32x4(value, value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<8>) -> reg { return _mm512_shuffle_f32x4(value, value, 0x4E); }
+
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            mask less = _mm512_cmp_ps_mask(rhs, lhs, _CMP_LT_OQ);
+            reg tmp = _mm512_mask_blend_ps(less, lhs, rhs);
+            rhs = _mm512_mask_blend_ps(less, rhs, lhs);
+            lhs = tmp;
+        }
+    };
+
+#elif defined(__AVX2__)
+
+    struct simd_ops_base
+    {
+        static constexpr std::size_t width = 8;
+        using mask = __m256i;
+
+        // Lanes whose index has any of the given bits set
+        static auto lane_bits(unsigned bits)
+            -> mask
+        {
+            return _mm256_setr_epi32(
+                (0 & bits) ? -1 : 0, (1 & bits) ? -1 : 0,
+                (2 & bits) ? -1 : 0, (3 & bits) ? -1 : 0,
+                (4 & bits) ? -1 : 0, (5 & bits) ? -1 : 0,
+                (6 & bits) ? -1 : 0, (7 & bits) ? -1 : 0
+            );
+        }
+
+        static auto uniform(bool value)
+            -> mask
+        {
+            return _mm256_set1_epi32(value ? -1 : 0);
+        }
+
+        static auto mask_xor(mask lhs, mask rhs)
+            -> mask
+        {
+            return _mm256_xor_si256(lhs, rhs);
+        }
+    };
+
+    struct simd_ops_int_base:
+        simd_ops_base
+    {
+        using reg = __m256i;
+
+        static auto load(const void* ptr) -> reg { return _mm256_loadu_si256(static_cast<const reg*>(ptr)); }
+        static auto store(void* ptr, reg value) -> void { _mm256_storeu_si256(static_cast<reg*>(ptr), value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm256_blendv_epi8(lhs, rhs, m); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm256_shuffle_epi32(value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm256_shuffle_epi32(value, 0x4E); }
+        static auto permute_xor(reg value, simd_index<4>) -> reg { return _mm256_permute2x128_si256(value, value, 0x01); }
+    };
+
+    template<>
+    struct simd_ops<std::int32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm256_min_epi32(lhs, rhs);
+            rhs = _mm256_max_epi32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<std::uint32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm256_min_epu32(lhs, rhs);
+            rhs = _mm256_max_epu32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<float>:
+        simd_ops_base
+    {
+        using reg = __m256;
+
+        static auto load(const void* ptr) -> reg { return _mm256_loadu_ps(static_cast<const float*>(ptr)); }
+        static auto store(void* ptr, reg value) -> void { _mm256_storeu_ps(static_cast<float*>(ptr), value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm256_blendv_ps(lhs, rhs, _mm256_castsi256_ps(m)); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm256_permute_ps(value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm256_permute_ps(value, 0x4E); }
+        static auto permute_xor(reg value, simd_index<4>) -> reg { return _mm256_permute2f128_ps(value, value, 0x01); }
+
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg less = _mm256_cmp_ps(rhs, lhs, _CMP_LT_OQ);
+            reg tmp = _mm256_blendv_ps(lhs, rhs, less);
+            rhs = _mm256_blendv_ps(rhs, lhs, less);
+            lhs = tmp;
+        }
+    };
+
+#elif defined(__SSE4_1__)
+
+    struct simd_ops_base
+    {
+        static constexpr std::size_t width = 4;
+        using mask = __m128i;
+
+        // Lanes whose index has any of the given bits set
+        static auto lane_bits(unsigned bits)
+            -> mask
+        {
+            return _mm_setr_epi32(
+                (0 & bits) ? -1 : 0, (1 & bits) ? -1 : 0,
+                (2 & bits) ? -1 : 0, (3 & bits) ? -1 : 0
+            );
+        }
+
+        static auto uniform(bool value)
+            -> mask
+        {
+            return _mm_set1_epi32(value ? -1 : 0);
+        }
+
+        static auto mask_xor(mask lhs, mask rhs)
+            -> mask
+        {
+            return _mm_xor_si128(lhs, rhs);
+        }
+    };
+
+    struct simd_ops_int_base:
+        simd_ops_base
+    {
+        using reg = __m128i;
+
+        static auto load(const void* ptr) -> reg { return _mm_loadu_si128(static_cast<const reg*>(ptr)); }
+        static auto store(void* ptr, reg value) -> void { _mm_storeu_si128(static_cast<reg*>(ptr), value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm_blendv_epi8(lhs, rhs, m); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm_shuffle_epi32(value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm_shuffle_epi32(value, 0x4E); }
+    };
+
+    template<>
+    struct simd_ops<std::int32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm_min_epi32(lhs, rhs);
+            rhs = _mm_max_epi32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<std::uint32_t>:
+        simd_ops_int_base
+    {
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg tmp = _mm_min_epu32(lhs, rhs);
+            rhs = _mm_max_epu32(lhs, rhs);
+            lhs = tmp;
+        }
+    };
+
+    template<>
+    struct simd_ops<float>:
+        simd_ops_base
+    {
+        using reg = __m128;
+
+        static auto load(const void* ptr) -> reg { return _mm_loadu_ps(static_cast<const float*>(ptr)); }
+        static auto store(void* ptr, reg value) -> void { _mm_storeu_ps(static_cast<float*>(ptr), value); }
+        static auto select(mask m, reg lhs, reg rhs) -> reg { return _mm_blendv_ps(lhs, rhs, _mm_castsi128_ps(m)); }
+
+        static auto permute_xor(reg value, simd_index<1>) -> reg { return _mm_shuffle_ps(value, value, 0xB1); }
+        static auto permute_xor(reg value, simd_index<2>) -> reg { return _mm_shuffle_ps(value, value, 0x4E); }
+
+        static auto minmax(reg& lhs, reg& rhs)
+            -> void
+        {
+            reg less = _mm_cmplt_ps(rhs, lhs);
+            reg tmp = _mm_blendv_ps(lhs, rhs, less);
+            rhs = _mm_blendv_ps(rhs, lhs, less);
+            lhs = tmp;
+        }
+    };
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Whether a collection can be sorted with simd_bitonic_sort
+
+    template<typename T, typename=void>
+    struct has_simd_ops:
+        std::false_type
+    {};
+
+    template<typename T>
+    struct has_simd_ops<T, std::enable_if_t<(simd_ops<T>::width > 0)>>:
+        std::true_type
+    {};
+
+    template<typename Compare, typename T>
+    struct simd_sort_order
+    {
+        static constexpr bool is_supported = false;
+        static constexpr bool is_descending = false;
+    };
+
+    template<typename T>
+    struct simd_sort_order<std::less<>, T>
+    {
+        static constexpr bool is_supported = true;
+        static constexpr bool is_descending = false;
+    };
+
+    template<typename T>
+    struct simd_sort_order<std::less<T>, T>:
+        simd_sort_order<std::less<>, T>
+    {};
+
+    template<typename T>
+    struct simd_sort_order<std::greater<>, T>
+    {
+        static constexpr bool is_supported = true;
+        static constexpr bool is_descending = true;
+    };
+
+    template<typename T>
+    struct simd_sort_order<std::greater<T>, T>:
+        simd_sort_order<std::greater<>, T>
+    {};
+
+    template<typename T, typename Compare, typename Projection>
+    struct is_simd_sortable:
+        std::integral_constant<bool,
+            has_simd_ops<T>::value &&
+            utility::is_probably_branchless_comparison_v<Compare, T> &&
+            simd_sort_order<Compare, T>::is_supported &&
+            std::is_same<Projection, utility::identity>::value
+        >
+    {};
+
+    template<typename T, typename Compare, typename Projection=utility::identity>
+    constexpr bool is_simd_sortable_v = is_simd_sortable<T, Compare, Projection>::value;
+
+    // Iterators known to point to contiguous memory, there is
+    // no way to detect contiguous iterators in general
+    template<typename Iterator>
+    struct is_contiguous_iterator:
+        std::integral_constant<bool,
+            std::is_pointer<Iterator>::value ||
+            std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::iterator>::value
+        >
+    {};
+
+    template<typename Iterator, typename Compare, typename Projection>
+    constexpr bool is_simd_sortable_iterator_v =
+        is_contiguous_iterator<Iterator>::value &&
+        is_simd_sortable_v<value_type_t<Iterator>, Compare, Projection>;
+
+    ////////////////////////////////////////////////////////////
+    // Sorting network
+
+    template<typename T, std::size_t NbRegs>
+    struct simd_bitonic_network
+    {
+        using ops = simd_ops<T>;
+        using reg = typename ops::reg;
+        static constexpr std::size_t width = ops::width;
+        static constexpr std::size_t size = NbRegs * width;
+
+        // Compare-exchange of the lanes at distance J in bitonic
+        // sequences of size K, lanes of different registers
+        template<std::size_t K, std::size_t J>
+        static auto exchange(reg* regs, std::true_type)
+            -> void
+        {
+            constexpr std::size_t reg_distance = J / width;
+            for (std::size_t i = 0 ; i < NbRegs ; ++i) {
+                if (i & reg_distance) continue;
+                if ((i * width) & K) {
+                    ops::minmax(regs[i + reg_distance], regs[i]);
+                } else {
+                    ops::minmax(regs[i], regs[i + reg_distance]);
+                }
+            }
+        }
+
+        // Compare-exchange of the lanes at distance J in bitonic
+        // sequences of size K, lanes of the same register
+        template<std::size_t K, std::size_t J>
+        static auto exchange(reg* regs, std::false_type)
+            -> void
+        {
+            // Lanes which receive the max of the pair: upper lanes of
+            // the ascending sequences and lower lanes of the other ones
+            auto max_lanes = ops::mask_xor(ops::lane_bits(J),
+                                           ops::lane_bits(K < width ? K : 0));
+            auto max_lanes_desc = ops::mask_xor(max_lanes, ops::uniform(true));
+
+            for (std::size_t i = 0 ; i < NbRegs ; ++i) {
+                reg low = regs[i];
+                reg high = ops::permute_xor(regs[i], simd_index<J>{});
+                ops::minmax(low, high);
+                bool descending = K >= width && ((i * width) & K);
+                regs[i] = ops::select(descending ? max_lanes_desc : max_lanes, low, high);
+            }
+        }
+
+        template<std::size_t K>
+        static auto merge(reg*, simd_index<0>)
+            -> void
+        {}
+
+        template<std::size_t K, std::size_t J>
+        static auto merge(reg* regs, simd_index<J>)
+            -> void
+        {
+            exchange<K, J>(regs, std::integral_constant<bool, (J >= width)>{});
+            merge<K>(regs, simd_index<J / 2>{});
+        }
+
+        template<std::size_t K>
+        static auto sort(reg*, std::false_type)
+            -> void
+        {}
+
+        template<std::size_t K>
+        static auto sort(reg* regs, std::true_type)
+            -> void
+        {
+            merge<K>(regs, simd_index<K / 2>{});
+            sort<K * 2>(regs, std::integral_constant<bool, (K * 2 <= size)>{});
+        }
+
+        static auto sort(T* data)
+            -> void
+        {
+            reg regs[NbRegs];
+            for (std::size_t i = 0 ; i < NbRegs ; ++i) {
+                regs[i] = ops::load(data + i * width);
+            }
+            sort<2>(regs, std::true_type{});
+            for (std::size_t i = 0 ; i < NbRegs ; ++i) {
+                ops::store(data + i * width, regs[i]);
+            }
+        }
+    };
+
+    template<typename T, std::size_t NbRegs>
+    auto simd_bitonic_sort_regs(T*, std::size_t, std::false_type)
+        -> void
+    {}
+
+    template<typename T, std::size_t NbRegs>
+    auto simd_bitonic_sort_regs(T* data, std::size_t nb_regs, std::true_type)
+        -> void
+    {
+        constexpr std::size_t width = simd_ops<T>::width;
+        if (nb_regs <= NbRegs) {
+            simd_bitonic_network<T, NbRegs>::sort(data);
+        } else {
+            simd_bitonic_sort_regs<T, NbRegs * 2>(
+                data, nb_regs,
+                std::integral_constant<bool, (NbRegs * 2 * width <= simd_sort_max_size)>{}
+            );
+        }
+    }
+
+    // Sorts [first, first + size) with size <= simd_sort_max_size
+    template<typename T, typename Compare>
+    auto simd_bitonic_sort(T* first, std::size_t size, Compare)
+        -> void
+    {
+        constexpr std::size_t width = simd_ops<T>::width;
+        constexpr bool is_descending = simd_sort_order<Compare, T>::is_descending;
+
+        // Pad the collection to a power of two with values that
+        // end up after every other element in ascending order
+        T buffer[simd_sort_max_size];
+        std::size_t nb_regs = (size + width - 1) / width;
+        std::size_t padded_size = width;
+        while (padded_size < nb_regs * width) {
+            padded_size *= 2;
+        }
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            buffer[i] = first[i];
+        }
+        T sentinel = std::numeric_limits<T>::has_infinity ?
+            std::numeric_limits<T>::infinity() :
+            std::numeric_limits<T>::max();
+        for (std::size_t i = size ; i < padded_size ; ++i) {
+            buffer[i] = sentinel;
+        }
+
+        simd_bitonic_sort_regs<T, 1>(buffer, padded_size / width, std::true_type{});
+
+        if (is_descending) {
+            for (std::size_t i = 0 ; i < size ; ++i) {
+                first[i] = buffer[size - i - 1];
+            }
+        } else {
+            for (std::size_t i = 0 ; i < size ; ++i) {
+                first[i] = buffer[i];
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Base case for the sorting algorithms: sorts the collection
+    // with simd_bitonic_sort if it is small enough and the types
+    // involved allow it, returns whether it was sorted
+
+    template<typename Iterator, typename Compare, typename Projection>
+    auto simd_small_sort(Iterator first, Iterator, difference_type_t<Iterator> size,
+                         Compare compare, Projection)
+        -> std::enable_if_t<is_simd_sortable_iterator_v<Iterator, Compare, Projection>, bool>
+    {
+        if (size > simd_sort_max_size) {
+            return false;
+        }
+        if (size > 1) {
+            simd_bitonic_sort(std::addressof(*first), std::size_t(size), compare);
+        }
+        return true;
+    }
+
+    template<typename Iterator, typename Compare, typename Projection>
+    auto simd_small_sort(Iterator, Iterator, difference_type_t<Iterator>,
+                         Compare, Projection)
+        -> std::enable_if_t<not is_simd_sortable_iterator_v<Iterator, Compare, Projection>, bool>
+    {
+        return false;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_BITONIC_SORT_H_
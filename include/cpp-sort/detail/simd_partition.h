@@ -0,0 +1,393 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SIMD_PARTITION_H_
+#define CPPSORT_DETAIL_SIMD_PARTITION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "simd_bitonic_sort.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // SIMD partition
+    //
+    // Partitions a contiguous collection of signed integers or
+    // floating point numbers around a pivot, a whole register at
+    // a time: the elements of a register that belong to the left
+    // partition are packed at its beginning and the other ones at
+    // its end, then it is written to both ends of the free space.
+    // AVX-512F has native compress-store instructions and handles
+    // 32-bit and 64-bit types, while AVX2 uses a permutation table
+    // indexed by the comparison mask and only handles 32-bit types
+
+    template<typename T, typename=void>
+    struct simd_partition_ops;
+
+    // Signed integers are handled according to their size since
+    // both long int and long long int can be 64-bit integers
+    template<typename T, std::size_t Size>
+    using enable_if_signed_integer_t = std::enable_if_t<
+        std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == Size
+    >;
+
+    // Permutation moving the 32-bit lanes whose bit is set in the
+    // index to the beginning of an AVX2 register and the other
+    // ones to its end, plus the number of bits set in the index
+    struct simd_partition_table
+    {
+        std::uint64_t permutations[256];
+        std::uint8_t popcounts[256];
+    };
+
+    constexpr auto make_simd_partition_table()
+        -> simd_partition_table
+    {
+        simd_partition_table table = {};
+        for (unsigned mask = 0 ; mask < 256 ; ++mask) {
+            std::uint64_t permutation = 0;
+            unsigned pos = 0;
+            for (unsigned lane = 0 ; lane < 8 ; ++lane) {
+                if (mask & (1u << lane)) {
+                    permutation |= std::uint64_t(lane) << (8 * pos++);
+                }
+            }
+            table.popcounts[mask] = std::uint8_t(pos);
+            for (unsigned lane = 0 ; lane < 8 ; ++lane) {
+                if (not (mask & (1u << lane))) {
+                    permutation |= std::uint64_t(lane) << (8 * pos++);
+                }
+            }
+            table.permutations[mask] = permutation;
+        }
+        return table;
+    }
+
+    inline auto get_simd_partition_table()
+        -> const simd_partition_table&
+    {
+        static constexpr simd_partition_table table = make_simd_partition_table();
+        return table;
+    }
+
+#if defined(__AVX512F__)
+
+    template<typename T, typename Mask>
+    struct simd_partition_ops_base
+    {
+        static constexpr std::ptrdiff_t width = 64 / sizeof(T);
+        using mask = Mask;
+
+        static auto count(mask m)
+            -> std::ptrdiff_t
+        {
+            auto& popcounts = get_simd_partition_table().popcounts;
+            return popcounts[m & 0xFF] + popcounts[(m >> 8) & 0xFF];
+        }
+    };
+
+    template<typename T>
+    struct simd_partition_ops<T, enable_if_signed_integer_t<T, 4>>:
+        simd_partition_ops_base<T, __mmask16>
+    {
+        using base = simd_partition_ops_base<T, __mmask16>;
+        using typename base::mask;
+        using base::width;
+        using reg = __m512i;
+
+        static auto load(const T* ptr) -> reg { return _mm512_loadu_si512(ptr); }
+        static auto set1(T value) -> reg { return _mm512_set1_epi32(value); }
+        static auto less(reg lhs, reg rhs) -> mask { return _mm512_cmplt_epi32_mask(lhs, rhs); }
+
+        static auto store(T* left, T* right, reg value, mask m, std::ptrdiff_t count)
+            -> void
+        {
+            _mm512_mask_compressstoreu_epi32(left, m, value);
+            _mm512_mask_compressstoreu_epi32(right - (width - count), mask(~m), value);
+        }
+    };
+
+    template<typename T>
+    struct simd_partition_ops<T, enable_if_signed_integer_t<T, 8>>:
+        simd_partition_ops_base<T, __mmask8>
+    {
+        using base = simd_partition_ops_base<T, __mmask8>;
+        using typename base::mask;
+        using base::width;
+        using reg = __m512i;
+
+        static auto load(const T* ptr) -> reg { return _mm512_loadu_si512(ptr); }
+        static auto set1(T value) -> reg { return _mm512_set1_epi64(value); }
+        static auto less(reg lhs, reg rhs) -> mask { return _mm512_cmplt_epi64_mask(lhs, rhs); }
+
+        static auto store(T* left, T* right, reg value, mask m, std::ptrdiff_t count)
+            -> void
+        {
+            _mm512_mask_compressstoreu_epi64(left, m, value);
+            _mm512_mask_compressstoreu_epi64(right - (width - count), mask(~m), value);
+        }
+    };
+
+    template<>
+    struct simd_partition_ops<float>:
+        simd_partition_ops_base<float, __mmask16>
+    {
+        using reg = __m512;
+
+        static auto load(const float* ptr) -> reg { return _mm512_loadu_ps(ptr); }
+        static auto set1(float value) -> reg { return _mm512_set1_ps(value); }
+        static auto less(reg lhs, reg rhs) -> mask { return _mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ); }
+
+        static auto store(float* left, float* right, reg value, mask m, std::ptrdiff_t count)
+            -> void
+        {
+            _mm512_mask_compressstoreu_ps(left, m, value);
+            _mm512_mask_compressstoreu_ps(right - (width - count), mask(~m), value);
+        }
+    };
+
+    template<>
+    struct simd_partition_ops<double>:
+        simd_partition_ops_base<double, __mmask8>
+    {
+        using reg = __m512d;
+
+        static auto load(const double* ptr) -> reg { return _mm512_loadu_pd(ptr); }
+        static auto set1(double value) -> reg { return _mm512_set1_pd(value); }
+        static auto less(reg lhs, reg rhs) -> mask { return _mm512_cmp_pd_mask(lhs, rhs, _CMP_LT_OQ); }
+
+        static auto store(double* left, double* right, reg value, mask m, std::ptrdiff_t count)
+            -> void
+        {
+            _mm512_mask_compressstoreu_pd(left, m, value);
+            _mm512_mask_compressstoreu_pd(right - (width - count), mask(~m), value);
+        }
+    };
+
+#elif defined(__AVX2__)
+
+    // With only 4 lanes per register the permutation overhead
+    // isn't worth it for 64-bit types, hence their absence here
+    template<typename T>
+    struct simd_partition_ops_base
+    {
+        static constexpr std::ptrdiff_t width = 8;
+        using mask = unsigned;
+
+        static auto count(mask m)
+            -> std::ptrdiff_t
+        {
+            return get_simd_partition_table().popcounts[m];
+        }
+
+        static auto store_bits(T* left, T* right, __m256i value, mask m)
+            -> void
+        {
+            auto permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(get_simd_partition_table().permutations + m)
+            ));
+            auto res = _mm256_permutevar8x32_epi32(value, permutation);
+            // Both stores write to the same place for the last register
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left), res);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right - width), res);
+        }
+    };
+
+    template<typename T>
+    struct simd_partition_ops<T, enable_if_signed_integer_t<T, 4>>:
+        simd_partition_ops_base<T>
+    {
+        using base = simd_partition_ops_base<T>;
+        using typename base::mask;
+        using base::store_bits;
+        using reg = __m256i;
+
+        static auto load(const T* ptr) -> reg { return _mm256_loadu_si256(reinterpret_cast<const reg*>(ptr)); }
+        static auto set1(T value) -> reg { return _mm256_set1_epi32(value); }
+
+        static auto less(reg lhs, reg rhs)
+            -> mask
+        {
+            return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rhs, lhs)));
+        }
+
+        static auto store(T* left, T* right, reg value, mask m, std::ptrdiff_t)
+            -> void
+        {
+            store_bits(left, right, value, m);
+        }
+    };
+
+    template<>
+    struct simd_partition_ops<float>:
+        simd_partition_ops_base<float>
+    {
+        using reg = __m256;
+
+        static auto load(const float* ptr) -> reg { return _mm256_loadu_ps(ptr); }
+        static auto set1(float value) -> reg { return _mm256_set1_ps(value); }
+
+        static auto less(reg lhs, reg rhs)
+            -> mask
+        {
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ));
+        }
+
+        static auto store(float* left, float* right, reg value, mask m, std::ptrdiff_t)
+            -> void
+        {
+            store_bits(left, right, _mm256_castps_si256(value), m);
+        }
+    };
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Whether a collection can be partitioned with simd_partition
+
+    template<typename T, typename=void>
+    struct has_simd_partition_ops:
+        std::false_type
+    {};
+
+    template<typename T>
+    struct has_simd_partition_ops<T, std::enable_if_t<(simd_partition_ops<T>::width > 0)>>:
+        std::true_type
+    {};
+
+    template<typename Iterator, typename Compare, typename Projection>
+    constexpr bool is_simd_partitionable_iterator_v =
+        is_contiguous_iterator<Iterator>::value &&
+        has_simd_partition_ops<value_type_t<Iterator>>::value &&
+        utility::is_probably_branchless_comparison_v<Compare, value_type_t<Iterator>> &&
+        simd_sort_order<Compare, value_type_t<Iterator>>::is_supported &&
+        std::is_same<Projection, utility::identity>::value;
+
+    ////////////////////////////////////////////////////////////
+    // Partition algorithm
+
+    // Moves the elements of [first, last) for which compare(elem, pivot)
+    // is true to the beginning of the collection and the other ones to
+    // its end, returns the beginning of the second partition. The order
+    // of the elements in the partitions is unspecified
+    template<typename T, typename Compare>
+    auto simd_partition(T* first, T* last, T pivot, Compare)
+        -> T*
+    {
+        using ops = simd_partition_ops<T>;
+        using reg = typename ops::reg;
+        constexpr std::ptrdiff_t width = ops::width;
+        constexpr bool is_descending = simd_sort_order<Compare, T>::is_descending;
+
+        reg pivot_reg = ops::set1(pivot);
+        auto goes_left = [&](reg value) {
+            return is_descending ? ops::less(pivot_reg, value) : ops::less(value, pivot_reg);
+        };
+        auto goes_left_scalar = [&](T value) {
+            return is_descending ? pivot < value : value < pivot;
+        };
+
+        T* write_left = first;
+        T* write_right = last;
+
+        if (last - first < 2 * width) {
+            // Too small to be worth it
+            T buffer[2 * width];
+            std::ptrdiff_t size = last - first;
+            for (std::ptrdiff_t i = 0 ; i < size ; ++i) {
+                buffer[i] = first[i];
+            }
+            for (std::ptrdiff_t i = 0 ; i < size ; ++i) {
+                if (goes_left_scalar(buffer[i])) {
+                    *write_left++ = buffer[i];
+                } else {
+                    *--write_right = buffer[i];
+                }
+            }
+            return write_left;
+        }
+
+        // Keep the first and last registers aside so that there
+        // is always room enough on both sides to store a whole
+        // register without overwriting unread elements
+        reg saved_left = ops::load(first);
+        reg saved_right = ops::load(last - width);
+        T* read_left = first + width;
+        T* read_right = last - width;
+
+        auto partition_reg = [&](reg value) {
+            auto m = goes_left(value);
+            auto count = ops::count(m);
+            ops::store(write_left, write_right, value, m, count);
+            write_left += count;
+            write_right -= width - count;
+        };
+
+        while (read_right - read_left >= width) {
+            // Read from the side with the least free space
+            reg value;
+            if (read_left - write_left <= write_right - read_right) {
+                value = ops::load(read_left);
+                read_left += width;
+            } else {
+                read_right -= width;
+                value = ops::load(read_right);
+            }
+            partition_reg(value);
+        }
+
+        // Partition the remaining elements one by one
+        T buffer[width];
+        std::ptrdiff_t remaining = read_right - read_left;
+        for (std::ptrdiff_t i = 0 ; i < remaining ; ++i) {
+            buffer[i] = read_left[i];
+        }
+        for (std::ptrdiff_t i = 0 ; i < remaining ; ++i) {
+            if (goes_left_scalar(buffer[i])) {
+                *write_left++ = buffer[i];
+            } else {
+                *--write_right = buffer[i];
+            }
+        }
+
+        partition_reg(saved_left);
+        partition_reg(saved_right);
+        return write_left;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_PARTITION_H_
@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
+#define CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "apply_permutation.h"
+#include "iterator_traits.h"
+#include "packed_key.h"
+#include "pdqsort.h"
+#include "ska_sort.h"
+#include "spreadsort/detail/string_sort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Sort strings on a cached prefix
+    //
+    // Comparing two strings means reading two heap buffers, which
+    // likely aren't in the cache. Instead, the first 8 characters
+    // of every string are packed into a big-endian integer stored
+    // next to the position of the string: the records are radix
+    // sorted on that integer, and the strings themselves are only
+    // read again to sort the runs of records sharing the same
+    // prefix. The elements are then moved once to their final
+    // position
+
+    template<typename String>
+    auto string_prefix(const String& str, std::size_t offset)
+        -> std::uint64_t
+    {
+        // Missing characters are zeroes, the strings that differ
+        // only by trailing zeroes are told apart by their size
+        std::uint64_t prefix = 0;
+        std::size_t size = str.size() > offset ? std::min<std::size_t>(str.size() - offset, 8) : 0;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            prefix |= std::uint64_t(static_cast<unsigned char>(str[offset + i])) << (56 - 8 * i);
+        }
+        return prefix;
+    }
+
+    // Sorts the runs of records with equal keys in a collection of
+    // records sorted on the characters [offset, offset + 8) of the
+    // strings; big runs are sorted again on the next characters,
+    // which avoids comparing long common prefixes over and over
+    template<typename PackedIterator, typename StringProjection>
+    auto sort_prefix_runs(PackedIterator first, PackedIterator last, std::size_t offset,
+                          StringProjection string_of, bool reverse)
+        -> void
+    {
+        using packed_t = value_type_t<PackedIterator>;
+        std::size_t next_offset = offset + 8;
+
+        while (first != last) {
+            auto run_end = std::next(first);
+            while (run_end != last && run_end->key == first->key) {
+                ++run_end;
+            }
+
+            if (std::distance(first, run_end) >= 64) {
+                // Cache the next characters of the strings
+                bool is_longer = false;
+                for (auto it = first ; it != run_end ; ++it) {
+                    auto&& str = string_of(*it);
+                    is_longer = is_longer || str.size() > next_offset;
+                    auto prefix = string_prefix(str, next_offset);
+                    it->key = reverse ? ~prefix : prefix;
+                }
+                if (is_longer) {
+                    ska_sort(first, run_end, [](const packed_t& value) { return value.key; });
+                    sort_prefix_runs(first, run_end, next_offset, string_of, reverse);
+                    first = run_end;
+                    continue;
+                }
+            }
+
+            // Only compare the characters after the cached ones,
+            // or the sizes of the strings if they are all shorter
+            if (std::distance(first, run_end) > 1) {
+                if (reverse) {
+                    pdqsort(first, run_end,
+                            spreadsort::detail::offset_greater_than<StringProjection, unsigned char>(
+                                next_offset, string_of),
+                            utility::identity{});
+                } else {
+                    pdqsort(first, run_end,
+                            spreadsort::detail::offset_less_than<StringProjection, unsigned char>(
+                                next_offset, string_of),
+                            utility::identity{});
+                }
+            }
+            first = run_end;
+        }
+    }
+
+    template<typename Index, typename RandomAccessIterator, typename Projection>
+    auto string_prefix_sort(RandomAccessIterator first, difference_type_t<RandomAccessIterator> size,
+                            Projection projection, bool reverse)
+        -> void
+    {
+        using packed_t = packed_key<std::uint64_t, Index>;
+        auto&& proj = utility::as_function(projection);
+
+        // Descending order is ascending order of the complemented
+        // prefixes, the ties are then sorted in reverse order
+        std::vector<packed_t> packed;
+        packed.reserve(size);
+        for (Index i = 0 ; i < Index(size) ; ++i) {
+            auto prefix = string_prefix(proj(first[i]), 0);
+            packed.push_back(packed_t{ reverse ? ~prefix : prefix, i });
+        }
+        ska_sort(std::begin(packed), std::end(packed),
+                 [](const packed_t& value) { return value.key; });
+
+        auto string_of = [&](const packed_t& value) -> decltype(auto) {
+            return proj(first[value.index]);
+        };
+        sort_prefix_runs(std::begin(packed), std::end(packed), 0, string_of, reverse);
+
+        apply_permutation_n(std::begin(packed), size,
+                            [](packed_t& value) -> Index& { return value.index; },
+                            std::move(first));
+    }
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto string_prefix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection, bool reverse)
+        -> void
+    {
+        // Packing the prefixes isn't worth it for small collections
+        auto size = last - first;
+        if (size < 128) {
+            if (reverse) {
+                pdqsort(std::move(first), std::move(last),
+                        std::greater<>{}, std::move(projection));
+            } else {
+                pdqsort(std::move(first), std::move(last),
+                        std::less<>{}, std::move(projection));
+            }
+            return;
+        }
+
+        // Use the smallest indices that can represent every
+        // position in the collection
+        if (std::uintmax_t(size) <= std::numeric_limits<std::uint32_t>::max()) {
+            string_prefix_sort<std::uint32_t>(std::move(first), size,
+                                              std::move(projection), reverse);
+        } else {
+            string_prefix_sort<std::size_t>(std::move(first), size,
+                                            std::move(projection), reverse);
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
@@ -0,0 +1,247 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_THREAD_POOL_H_
+#define CPPSORT_DETAIL_THREAD_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Thread pool
+    //
+    // Pool of worker threads shared by the parallel algorithms
+    // of the library. Idle workers take the oldest pending task
+    // (usually the biggest chunk of work) while threads waiting
+    // for a task_group to complete help by running the newest
+    // pending task, so nested parallel calls never deadlock and
+    // the calling thread is never idle while there is work left
+
+    class thread_pool
+    {
+        public:
+
+            explicit thread_pool(std::size_t nb_workers)
+            {
+                _workers.reserve(nb_workers);
+                for (std::size_t i = 0 ; i < nb_workers ; ++i) {
+                    _workers.emplace_back([this] { work(); });
+                }
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _condition.notify_all();
+                for (auto& worker: _workers) {
+                    worker.join();
+                }
+            }
+
+            // Number of threads able to run tasks at once,
+            // including the thread waiting for the results
+            auto concurrency() const
+                -> std::size_t
+            {
+                return _workers.size() + 1;
+            }
+
+            auto push(std::function<void()> task)
+                -> void
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _tasks.push_back(std::move(task));
+                }
+                _condition.notify_one();
+            }
+
+            // Runs the most recently pushed task if any,
+            // returns whether a task was run
+            auto try_run_one()
+                -> bool
+            {
+                std::function<void()> task;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_tasks.empty()) {
+                        return false;
+                    }
+                    task = std::move(_tasks.back());
+                    _tasks.pop_back();
+                }
+                task();
+                return true;
+            }
+
+        private:
+
+            auto work()
+                -> void
+            {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _condition.wait(lock, [this] {
+                            return _stop || not _tasks.empty();
+                        });
+                        if (_tasks.empty()) {
+                            return;
+                        }
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+
+            std::vector<std::thread> _workers;
+            std::deque<std::function<void()>> _tasks;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _stop = false;
+    };
+
+    inline auto default_thread_pool()
+        -> thread_pool&
+    {
+        // Always spawn at least one worker so that the parallel
+        // code paths are actually parallel everywhere
+        static thread_pool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return pool;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Group of tasks
+    //
+    // Tasks run in a task_group may add new tasks to the same
+    // group; wait() returns once every one of them has been run
+    // and rethrows the first exception thrown by a task if any
+
+    class task_group
+    {
+        public:
+
+            explicit task_group(thread_pool& pool=default_thread_pool()):
+                _pool(pool),
+                _pending(0)
+            {}
+
+            task_group(const task_group&) = delete;
+            task_group& operator=(const task_group&) = delete;
+
+            ~task_group()
+            {
+                // Tasks generally reference data owned by the
+                // caller, make sure none of them outlives it
+                join();
+            }
+
+            auto concurrency() const
+                -> std::size_t
+            {
+                return _pool.concurrency();
+            }
+
+            template<typename Function>
+            auto run(Function function)
+                -> void
+            {
+                // The counter is incremented first since a worker may
+                // run the task as soon as it is pushed, but the task
+                // is never run if it can't be pushed
+                _pending.fetch_add(1, std::memory_order_relaxed);
+                try {
+                    _pool.push([this, function]() mutable {
+                        try {
+                            function();
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (not _exception) {
+                                _exception = std::current_exception();
+                            }
+                        }
+                        // The group may be destroyed as soon as the
+                        // counter reaches zero, don't touch it anymore
+                        _pending.fetch_sub(1, std::memory_order_release);
+                    });
+                } catch (...) {
+                    _pending.fetch_sub(1, std::memory_order_relaxed);
+                    throw;
+                }
+            }
+
+            auto wait()
+                -> void
+            {
+                join();
+                if (_exception) {
+                    std::exception_ptr exception = nullptr;
+                    std::swap(exception, _exception);
+                    std::rethrow_exception(exception);
+                }
+            }
+
+        private:
+
+            auto join()
+                -> void
+            {
+                while (_pending.load(std::memory_order_acquire) != 0) {
+                    if (not _pool.try_run_one()) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            thread_pool& _pool;
+            std::atomic<std::size_t> _pending;
+            std::mutex _mutex;
+            std::exception_ptr _exception;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_THREAD_POOL_H_
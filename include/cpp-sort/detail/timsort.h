@@ -42,6 +42,8 @@
 #include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "bitops.h"
 #include "iterator_traits.h"
 #include "lower_bound.h"
 #include "memory.h"
@@ -65,6 +67,7 @@ namespace detail
 
         compare_type comp_;
         Projection proj_;
+        utility::memory_resource* resource_;
 
         static constexpr int min_merge = 32;
         static constexpr int min_gallop = 7;
@@ -81,9 +84,10 @@ namespace detail
                 len(std::move(len))
             {}
         };
-        std::vector<run> pending_;
+        std::vector<run, resource_allocator<run>> pending_;
 
-        static auto sort(iterator const lo, iterator const hi, compare_type c, Projection projection)
+        static auto sort(iterator const lo, iterator const hi, compare_type c, Projection projection,
+                         utility::memory_resource* resource)
             -> void
         {
             assert( lo <= hi );
@@ -99,7 +103,10 @@ namespace detail
                 return;
             }
 
-            TimSort ts(c, projection);
+            TimSort ts(c, projection, resource);
+            // The merge invariants make the run lengths grow at least as
+            // fast as Fibonacci numbers, which bounds the size of the stack
+            ts.pending_.reserve(2 * detail::log2(nRemaining));
             difference_type const minRun = minRunLength(nRemaining);
             iterator cur          = lo;
             do {
@@ -187,9 +194,9 @@ namespace detail
             return n + r;
         }
 
-        TimSort(compare_type comp, Projection projection):
-            comp_(std::move(comp)), proj_(std::move(projection)),
-            minGallop_(min_gallop)
+        TimSort(compare_type comp, Projection projection, utility::memory_resource* resource):
+            comp_(std::move(comp)), proj_(std::move(projection)), resource_(resource),
+            minGallop_(min_gallop), pending_(resource_allocator<run>(resource))
         {}
 
         auto pushRun(iterator const runBase, difference_type const runLen)
@@ -403,9 +410,7 @@ namespace detail
 
             using utility::iter_move;
 
-            std::unique_ptr<rvalue_reference, operator_deleter> buffer(
-                static_cast<rvalue_reference*>(::operator new(len1 * sizeof(rvalue_reference)))
-            );
+            auto buffer = allocate_buffer<rvalue_reference>(resource_, len1);
             destruct_n<rvalue_reference> d(0);
             std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(buffer.get(), d);
 
@@ -549,9 +554,7 @@ namespace detail
             assert( base1 + len1 == base2 );
             using utility::iter_move;
 
-            std::unique_ptr<rvalue_reference, operator_deleter> buffer(
-                static_cast<rvalue_reference*>(::operator new(len2 * sizeof(rvalue_reference)))
-            );
+            auto buffer = allocate_buffer<rvalue_reference>(resource_, len2);
             destruct_n<rvalue_reference> d(0);
             std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(buffer.get(), d);
 
@@ -693,18 +696,19 @@ namespace detail
 
         // the only interface is the friend timsort() function
         template<typename IterT, typename LessT, typename Proj>
-        friend void timsort(IterT, IterT, LessT, Proj);
+        friend void timsort(IterT, IterT, LessT, Proj, utility::memory_resource*);
     };
 
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto timsort(RandomAccessIterator const first, RandomAccessIterator const last,
-                 Compare compare, Projection projection)
+                 Compare compare, Projection projection,
+                 utility::memory_resource* resource)
         -> void
     {
         using compare_t = std::decay_t<decltype(utility::as_function(compare))>;
         TimSort<RandomAccessIterator, compare_t, Projection>::sort(std::move(first), std::move(last),
                                                                    utility::as_function(compare),
-                                                                   std::move(projection));
+                                                                   std::move(projection), resource);
     }
 }}
 
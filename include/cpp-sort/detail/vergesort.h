@@ -32,10 +32,12 @@
 #include <utility>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/memory_resource.h>
 #include "bitops.h"
 #include "inplace_merge.h"
 #include "is_sorted_until.h"
 #include "iterator_traits.h"
+#include "memory.h"
 #include "quicksort.h"
 #include "reverse.h"
 
@@ -46,7 +48,7 @@ namespace detail
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto vergesort(BidirectionalIterator first, BidirectionalIterator last,
                    Compare compare, Projection projection,
-                   std::bidirectional_iterator_tag)
+                   utility::memory_resource* resource, std::bidirectional_iterator_tag)
         -> void
     {
         using difference_type = difference_type_t<BidirectionalIterator>;
@@ -97,15 +99,15 @@ namespace detail
                 {
                     quicksort(begin_unstable, begin_rng, size_unstable, compare, projection);
                     detail::reverse(begin_rng, next);
-                    detail::inplace_merge(begin_unstable, begin_rng, next, compare, projection);
-                    detail::inplace_merge(first, begin_unstable, next, compare, projection);
+                    detail::inplace_merge(begin_unstable, begin_rng, next, compare, projection, resource);
+                    detail::inplace_merge(first, begin_unstable, next, compare, projection, resource);
                     begin_unstable = last;
                     size_unstable = 0;
                 }
                 else
                 {
                     detail::reverse(begin_rng, next);
-                    detail::inplace_merge(first, begin_rng, next, compare, projection);
+                    detail::inplace_merge(first, begin_rng, next, compare, projection, resource);
                 }
             }
             else
@@ -136,14 +138,14 @@ namespace detail
                 if (begin_unstable != last)
                 {
                     quicksort(begin_unstable, begin_rng, size_unstable, compare, projection);
-                    detail::inplace_merge(begin_unstable, begin_rng, next, compare, projection);
-                    detail::inplace_merge(first, begin_unstable, next, compare, projection);
+                    detail::inplace_merge(begin_unstable, begin_rng, next, compare, projection, resource);
+                    detail::inplace_merge(first, begin_unstable, next, compare, projection, resource);
                     begin_unstable = last;
                     size_unstable = 0;
                 }
                 else
                 {
-                    detail::inplace_merge(first, begin_rng, next, compare, projection);
+                    detail::inplace_merge(first, begin_rng, next, compare, projection, resource);
                 }
             }
             else
@@ -162,7 +164,7 @@ namespace detail
         {
             quicksort(begin_unstable, last, size_unstable, compare, projection);
             detail::inplace_merge(first, begin_unstable, last,
-                                  std::move(compare), std::move(projection));
+                                  std::move(compare), std::move(projection), resource);
         }
     }
 
@@ -170,7 +172,7 @@ namespace detail
              typename Projection, typename Fallback>
     auto vergesort(RandomAccessIterator first, RandomAccessIterator last,
                    Compare compare, Projection projection, Fallback fallback,
-                   std::random_access_iterator_tag)
+                   utility::memory_resource* resource, std::random_access_iterator_tag)
         -> void
     {
         using difference_type = difference_type_t<RandomAccessIterator>;
@@ -189,7 +191,7 @@ namespace detail
         // Vergesort detects big runs in ascending or descending order,
         // and remember where each run ends by storing the end iterator
         // of each run in this list, then it merges everything in the end
-        std::list<RandomAccessIterator> runs;
+        std::list<RandomAccessIterator, resource_allocator<RandomAccessIterator>> runs(resource);
 
         // Beginning of an unstable partition, or last if the previous
         // partition is stable
@@ -315,7 +317,7 @@ namespace detail
             auto begin = first;
             for (auto it = runs.begin() ; it != runs.end() && it != std::prev(runs.end()) ; ++it) {
                 detail::inplace_merge(begin, *it, *std::next(it),
-                                      compare, projection);
+                                      compare, projection, resource);
 
                 // Remove the middle iterator and advance
                 it = runs.erase(it);
@@ -327,35 +329,37 @@ namespace detail
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto vergesort(RandomAccessIterator first, RandomAccessIterator last,
                    Compare compare, Projection projection,
-                   std::random_access_iterator_tag category)
+                   utility::memory_resource* resource, std::random_access_iterator_tag category)
         -> void
     {
         using sorter = cppsort::pdq_sorter;
         vergesort(std::move(first), std::move(last),
                   std::move(compare), std::move(projection),
-                  sorter{}, category);
+                  sorter{}, resource, category);
     }
 
     template<typename BidirectionalIterator, typename Compare,
              typename Projection, typename Fallback>
     auto vergesort(BidirectionalIterator first, BidirectionalIterator last,
-                   Compare compare, Projection projection, Fallback fallback)
+                   Compare compare, Projection projection, Fallback fallback,
+                   utility::memory_resource* resource)
         -> void
     {
         vergesort(std::move(first), std::move(last),
                   std::move(compare), std::move(projection),
-                  std::move(fallback), std::random_access_iterator_tag{});
+                  std::move(fallback), resource, std::random_access_iterator_tag{});
     }
 
     template<typename BidirectionalIterator, typename Compare, typename Projection>
     auto vergesort(BidirectionalIterator first, BidirectionalIterator last,
-                   Compare compare, Projection projection)
+                   Compare compare, Projection projection,
+                   utility::memory_resource* resource)
         -> void
     {
         using category = iterator_category_t<BidirectionalIterator>;
         vergesort(std::move(first), std::move(last),
                   std::move(compare), std::move(projection),
-                  category{});
+                  resource, category{});
     }
 }}
 
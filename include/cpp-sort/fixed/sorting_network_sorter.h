@@ -28,11 +28,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/simd_bitonic_sort.h"
 
 namespace cppsort
 {
@@ -49,11 +52,34 @@ namespace cppsort
                 "sorting_network_sorter has no specialization for this size of N"
             );
         };
+
+        // Sorts contiguous collections of 32-bit arithmetic types
+        // with SIMD instructions when they are available, and falls
+        // back to the scalar sorting networks otherwise; the scalar
+        // networks are faster for the smallest sizes
+
+        template<std::size_t N>
+        struct simd_sorting_network_sorter_impl:
+            sorting_network_sorter_impl<N>
+        {
+            using sorting_network_sorter_impl<N>::operator();
+
+            template<
+                typename T,
+                typename Compare = std::less<>,
+                typename = std::enable_if_t<(N > 8) && is_simd_sortable_v<T, Compare>>
+            >
+            auto operator()(T* first, T*, Compare compare={}, utility::identity={}) const
+                -> void
+            {
+                simd_bitonic_sort(first, N, compare);
+            }
+        };
     }
 
     template<std::size_t N>
     struct sorting_network_sorter:
-        sorter_facade<detail::sorting_network_sorter_impl<N>>
+        sorter_facade<detail::simd_sorting_network_sorter_impl<N>>
     {};
 
     ////////////////////////////////////////////////////////////
@@ -43,6 +43,7 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // Sorters
 
+    struct adaptive_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct counting_sorter;
@@ -56,6 +57,11 @@ namespace cppsort
     struct integer_spread_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct parallel_counting_sorter;
+    struct parallel_merge_sorter;
+    struct parallel_pdq_sorter;
+    struct parallel_ska_sorter;
+    struct parallel_string_spread_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
     struct quick_sorter;
@@ -64,6 +70,7 @@ namespace cppsort
     struct smooth_sorter;
     struct spread_sorter;
     struct std_sorter;
+    struct string_prefix_sorter;
     struct string_spread_sorter;
     struct tim_sorter;
     struct verge_sorter;
@@ -90,6 +97,8 @@ namespace cppsort
     template<typename Sorter>
     struct indirect_adapter;
     template<typename Sorter>
+    struct instrumented_adapter;
+    template<typename Sorter>
     struct schwartz_adapter;
     template<typename Sorter>
     struct self_sort_adapter;
@@ -37,5 +37,8 @@
 #include <cpp-sort/probes/par.h>
 #include <cpp-sort/probes/rem.h>
 #include <cpp-sort/probes/runs.h>
+#include <cpp-sort/probes/sampled_inv.h>
+#include <cpp-sort/probes/sampled_rem.h>
+#include <cpp-sort/probes/sampled_runs.h>
 
 #endif // CPPSORT_PROBES_H_
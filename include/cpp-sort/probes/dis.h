@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
@@ -62,11 +64,65 @@ namespace probe
                 auto&& comp = utility::as_function(compare);
                 auto&& proj = utility::as_function(projection);
 
-                if (first == last || std::next(first) == last)
+                auto size = std::distance(first, last);
+                if (size < 2)
                 {
                     return 0;
                 }
 
+                // Try to allocate enough memory to use a O(n) algorithm
+                std::unique_ptr<ForwardIterator[]> suffix_min(new (std::nothrow) ForwardIterator[size]);
+
+                if (suffix_min != nullptr)
+                {
+                    ////////////////////////////////////////////////////////////
+                    // Use a O(n) algorithm if enough memory could be allocated:
+                    // for every element that is bigger than all the previous
+                    // ones, find the last element smaller than it; since both
+                    // the prefix maxima and the suffix minima are sorted, the
+                    // search can resume from where the previous one stopped
+
+                    // suffix_min[i] points to the minimum of [i, size)
+                    auto store = suffix_min.get();
+                    for (ForwardIterator it = first ; it != last ; ++it)
+                    {
+                        *store++ = it;
+                    }
+                    for (auto i = size - 1 ; i > 0 ; --i)
+                    {
+                        if (not comp(proj(*suffix_min[i - 1]), proj(*suffix_min[i])))
+                        {
+                            suffix_min[i - 1] = suffix_min[i];
+                        }
+                    }
+
+                    difference_type max_dist = 0;
+                    difference_type j = 0;
+                    auto prefix_max = first;
+                    difference_type i = 0;
+                    for (auto it = first ; it != last ; ++it, ++i)
+                    {
+                        if (i > 0 && not comp(proj(*prefix_max), proj(*it)))
+                        {
+                            continue;
+                        }
+                        prefix_max = it;
+
+                        // The last element smaller than *it is at j - 1
+                        auto&& value = proj(*it);
+                        while (j < size && comp(proj(*suffix_min[j]), value))
+                        {
+                            ++j;
+                        }
+                        max_dist = std::max(max_dist, j - 1 - i);
+                    }
+                    return max_dist;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Use a O(n^2) algorithm if not enough memory could be
+                // allocated
+
                 difference_type max_dist = 0;
                 for (auto it1 = first ; it1 != last ; ++it1)
                 {
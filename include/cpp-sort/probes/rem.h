@@ -73,16 +73,13 @@ namespace probe
                 std::vector<ForwardIterator> stack_tops;
 
                 auto deref_compare = [&](const auto& lhs, auto rhs_it) mutable {
-                    return comp(lhs, *rhs_it);
-                };
-                auto deref_proj = [&](const auto& value) mutable -> decltype(auto) {
-                    return proj(value);
+                    return comp(lhs, proj(*rhs_it));
                 };
 
                 while (first != last) {
                     auto it = cppsort::detail::upper_bound(
                         std::begin(stack_tops), std::end(stack_tops),
-                        proj(*first), deref_compare, deref_proj);
+                        proj(*first), deref_compare, utility::identity{});
 
                     if (it == std::end(stack_tops)) {
                         // The element is bigger than everything else,
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_PROBES_SAMPLED_INV_H_
+#define CPPSORT_PROBES_SAMPLED_INV_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/indirect_compare.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/sampling.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Approximate Inv
+    //
+    // Counts the inversions between the elements of a sample of
+    // sample_size elements and scales the proportion of inverted
+    // pairs to the whole collection. The error is smaller than
+    // eps * n(n-1)/2 with probability 1 - 2exp(-2 floor(k/2) eps^2)
+    // for a sample of size k: with the default k = 4096, it is
+    // below 3% of the maximum with probability 95%.
+    //
+    // Runs in O(k log k) for random-access iterators and O(n) for
+    // other iterators, collections no bigger than the sample are
+    // measured exactly.
+
+    namespace detail
+    {
+        struct sampled_inv_impl
+        {
+            constexpr sampled_inv_impl() noexcept = default;
+
+            constexpr explicit sampled_inv_impl(std::ptrdiff_t sample_size,
+                                                std::uint64_t seed=cppsort::detail::default_sampling_seed) noexcept:
+                // Smaller samples are clamped: at least one pair of
+                // elements is needed to scale the number of inversions
+                _sample_size(sample_size < 2 ? 2 : sample_size),
+                _seed(seed)
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> cppsort::detail::difference_type_t<ForwardIterator>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+
+                auto size = std::distance(first, last);
+                if (size <= _sample_size) {
+                    return probe::inv(std::move(first), std::move(last),
+                                      std::move(compare), std::move(projection));
+                }
+
+                cppsort::detail::splitmix64 random(_seed);
+                auto sample = cppsort::detail::sample_iterators(
+                    std::move(first), std::move(last), size, _sample_size, random
+                );
+                auto inversions = probe::inv(
+                    sample, std::move(compare),
+                    cppsort::detail::indirect_projection<Projection>(std::move(projection))
+                );
+
+                double sample_pairs = double(_sample_size) * double(_sample_size - 1) / 2.0;
+                double pairs = double(size) * double(size - 1) / 2.0;
+                return static_cast<difference_type>(inversions / sample_pairs * pairs + 0.5);
+            }
+
+        private:
+
+            std::ptrdiff_t _sample_size = 4096;
+            std::uint64_t _seed = cppsort::detail::default_sampling_seed;
+        };
+    }
+
+    struct sampled_inv_probe:
+        sorter_facade<detail::sampled_inv_impl>
+    {
+        using sorter_facade<detail::sampled_inv_impl>::sorter_facade;
+    };
+
+    namespace
+    {
+        constexpr auto&& sampled_inv = utility::static_const<
+            sampled_inv_probe
+        >::value;
+    }
+}}
+
+#endif // CPPSORT_PROBES_SAMPLED_INV_H_
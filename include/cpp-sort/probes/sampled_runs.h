@@ -0,0 +1,159 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_PROBES_SAMPLED_RUNS_H_
+#define CPPSORT_PROBES_SAMPLED_RUNS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/sampling.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Approximate Runs
+    //
+    // Checks sample_size pairs of adjacent elements and scales
+    // the proportion of step-downs to the whole collection. The
+    // error is smaller than eps * (n-1) with probability
+    // 1 - 2exp(-2k eps^2) for a sample of size k: with the default
+    // k = 4096, it is below 2.2% of the maximum with probability
+    // 95%.
+    //
+    // Runs in O(k) for random-access iterators; Runs is computed
+    // exactly in a single pass for other iterators, as well as
+    // for collections no bigger than the sample.
+
+    namespace detail
+    {
+        struct sampled_runs_impl
+        {
+            constexpr sampled_runs_impl() noexcept = default;
+
+            constexpr explicit sampled_runs_impl(std::ptrdiff_t sample_size,
+                                                 std::uint64_t seed=cppsort::detail::default_sampling_seed) noexcept:
+                // Smaller samples are clamped: at least one pair of
+                // adjacent elements is needed to scale the step downs
+                _sample_size(sample_size < 1 ? 1 : sample_size),
+                _seed(seed)
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> cppsort::detail::difference_type_t<ForwardIterator>
+            {
+                return sampled_runs(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection),
+                                    cppsort::detail::iterator_category_t<ForwardIterator>{});
+            }
+
+        private:
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto sampled_runs(ForwardIterator first, ForwardIterator last,
+                              Compare compare, Projection projection,
+                              std::forward_iterator_tag) const
+                -> cppsort::detail::difference_type_t<ForwardIterator>
+            {
+                return probe::runs(std::move(first), std::move(last),
+                                   std::move(compare), std::move(projection));
+            }
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sampled_runs(RandomAccessIterator first, RandomAccessIterator last,
+                              Compare compare, Projection projection,
+                              std::random_access_iterator_tag) const
+                -> cppsort::detail::difference_type_t<RandomAccessIterator>
+            {
+                using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+                auto pairs = std::distance(first, last) - 1;
+                if (pairs <= _sample_size) {
+                    return probe::runs(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection));
+                }
+
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                // Sample the first elements of the pairs
+                cppsort::detail::splitmix64 random(_seed);
+                auto sample = cppsort::detail::sample_iterators(
+                    first, std::prev(last), pairs, _sample_size, random
+                );
+
+                difference_type step_downs = 0;
+                for (auto it: sample) {
+                    if (not comp(proj(*it), proj(*std::next(it)))) {
+                        ++step_downs;
+                    }
+                }
+
+                return static_cast<difference_type>(
+                    double(step_downs) / double(_sample_size) * double(pairs) + 0.5
+                );
+            }
+
+            std::ptrdiff_t _sample_size = 4096;
+            std::uint64_t _seed = cppsort::detail::default_sampling_seed;
+        };
+    }
+
+    struct sampled_runs_probe:
+        sorter_facade<detail::sampled_runs_impl>
+    {
+        using sorter_facade<detail::sampled_runs_impl>::sorter_facade;
+    };
+
+    namespace
+    {
+        constexpr auto&& sampled_runs = utility::static_const<
+            sampled_runs_probe
+        >::value;
+    }
+}}
+
+#endif // CPPSORT_PROBES_SAMPLED_RUNS_H_
@@ -0,0 +1,268 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORT_COLUMNS_H_
+#define CPPSORT_SORT_COLUMNS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sort_indices.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/size.h>
+#include "detail/detection.h"
+#include "detail/iterator_traits.h"
+#include "detail/logical_traits.h"
+#include "detail/packed_key.h"
+
+namespace cppsort
+{
+    namespace detail
+    {
+        template<typename Iterable>
+        using begin_t = decltype(std::begin(std::declval<Iterable&>()));
+
+        template<typename... Iterables>
+        using are_iterables = conjunction<is_detected<begin_t, Iterables>...>;
+
+        template<typename RandomAccessIterator>
+        auto take_key(RandomAccessIterator it, std::true_type /* copy */)
+            -> value_type_t<RandomAccessIterator>
+        {
+            return *it;
+        }
+
+        template<typename RandomAccessIterator>
+        auto take_key(RandomAccessIterator it, std::false_type /* copy */)
+            -> rvalue_reference_t<RandomAccessIterator>
+        {
+            using utility::iter_move;
+            return iter_move(it);
+        }
+
+        template<
+            typename Index,
+            typename Sorter,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename... RandomAccessIterators
+        >
+        auto sort_columns(const Sorter& sorter,
+                          RandomAccessIterator first, difference_type_t<RandomAccessIterator> size,
+                          Compare compare, Projection projection,
+                          RandomAccessIterators... columns)
+            -> void
+        {
+            using key_t = value_type_t<RandomAccessIterator>;
+            using packed_t = packed_key<key_t, Index>;
+
+            // Copy the keys when possible so that the key column is
+            // left untouched if the sort throws, otherwise move them
+            // out of the column and put them back on failure
+            using copy_keys = std::is_copy_constructible<key_t>;
+
+            std::vector<packed_t> packed;
+            packed.reserve(size);
+
+            // Sort the keys, the other columns are left untouched
+            auto key_projection = [&projection](const packed_t& value) -> decltype(auto) {
+                auto&& proj = utility::as_function(projection);
+                return proj(value.key);
+            };
+
+            try {
+                // Pack every key with its original position
+                for (Index i = 0 ; i < Index(size) ; ++i) {
+                    packed.push_back(packed_t{ take_key(first + i, copy_keys{}), i });
+                }
+
+                sort_indices_impl(sorter, std::begin(packed), std::end(packed),
+                                  std::move(compare), key_projection,
+                                  std::integral_constant<bool,
+                                      is_comparison_projection_sorter_iterator_v<
+                                          Sorter, typename std::vector<packed_t>::iterator,
+                                          Compare, decltype(key_projection)
+                                      >
+                                  >{});
+            } catch (...) {
+                // The keys were moved out of the column: put them back
+                // at their original positions so that the columns are
+                // left unsorted but still consistent with each other;
+                // keys lost by the sorter itself can't be recovered
+                if (not copy_keys::value) {
+                    for (auto& value: packed) {
+                        first[value.index] = std::move(value.key);
+                    }
+                }
+                throw;
+            }
+
+            // The keys are already in order, the companion columns
+            // are reordered according to the original positions
+            for (Index i = 0 ; i < Index(size) ; ++i) {
+                first[i] = std::move(packed[i].key);
+            }
+            apply_permutation_n(std::begin(packed), size,
+                                [](const packed_t& value) { return value.index; },
+                                std::move(columns)...);
+        }
+
+        template<
+            typename Sorter,
+            typename RandomAccessIterable,
+            typename Compare,
+            typename Projection,
+            typename... RandomAccessIterables
+        >
+        auto sort_columns(const Sorter& sorter, RandomAccessIterable&& keys,
+                          Compare compare, Projection projection,
+                          RandomAccessIterables&&... columns)
+            -> void
+        {
+            // Check the sizes before touching anything
+            auto size = utility::size(keys);
+            bool sizes_match = true;
+            (void) std::initializer_list<int>{
+                (sizes_match = sizes_match && std::uintmax_t(utility::size(columns)) == std::uintmax_t(size), 0)...
+            };
+            if (not sizes_match) {
+                throw std::invalid_argument("sort_columns: all the columns must have the same size");
+            }
+
+            // Use the smallest indices that can represent every
+            // position in the columns
+            if (std::uintmax_t(size) <= std::numeric_limits<std::uint32_t>::max()) {
+                sort_columns<std::uint32_t>(sorter, std::begin(keys), size,
+                                            std::move(compare), std::move(projection),
+                                            std::begin(columns)...);
+            } else {
+                sort_columns<std::size_t>(sorter, std::begin(keys), size,
+                                          std::move(compare), std::move(projection),
+                                          std::begin(columns)...);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort a key column and reorder the companion columns
+    // in lockstep, throws std::invalid_argument when the
+    // columns don't have the same size
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename... RandomAccessIterables,
+        typename = std::enable_if_t<
+            detail::are_iterables<RandomAccessIterables...>::value
+        >
+    >
+    auto sort_columns(const Sorter& sorter, RandomAccessIterable&& keys,
+                      RandomAccessIterables&&... columns)
+        -> void
+    {
+        detail::sort_columns(sorter, std::forward<RandomAccessIterable>(keys),
+                             std::less<>{}, utility::identity{},
+                             std::forward<RandomAccessIterables>(columns)...);
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Compare,
+        typename... RandomAccessIterables,
+        typename = std::enable_if_t<
+            not detail::are_iterables<Compare>::value &&
+            is_projection_v<utility::identity, RandomAccessIterable, Compare> &&
+            detail::are_iterables<RandomAccessIterables...>::value
+        >
+    >
+    auto sort_columns(const Sorter& sorter, RandomAccessIterable&& keys,
+                      Compare compare, RandomAccessIterables&&... columns)
+        -> void
+    {
+        detail::sort_columns(sorter, std::forward<RandomAccessIterable>(keys),
+                             std::move(compare), utility::identity{},
+                             std::forward<RandomAccessIterables>(columns)...);
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Projection,
+        typename... RandomAccessIterables,
+        typename = std::enable_if_t<
+            not detail::are_iterables<Projection>::value &&
+            not is_projection_v<utility::identity, RandomAccessIterable, Projection> &&
+            is_projection_v<Projection, RandomAccessIterable> &&
+            detail::are_iterables<RandomAccessIterables...>::value
+        >,
+        typename = void
+    >
+    auto sort_columns(const Sorter& sorter, RandomAccessIterable&& keys,
+                      Projection projection, RandomAccessIterables&&... columns)
+        -> void
+    {
+        detail::sort_columns(sorter, std::forward<RandomAccessIterable>(keys),
+                             std::less<>{}, std::move(projection),
+                             std::forward<RandomAccessIterables>(columns)...);
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Compare,
+        typename Projection,
+        typename... RandomAccessIterables,
+        typename = std::enable_if_t<
+            not detail::are_iterables<Compare>::value &&
+            not detail::are_iterables<Projection>::value &&
+            is_projection_v<Projection, RandomAccessIterable, Compare> &&
+            detail::are_iterables<RandomAccessIterables...>::value
+        >
+    >
+    auto sort_columns(const Sorter& sorter, RandomAccessIterable&& keys,
+                      Compare compare, Projection projection,
+                      RandomAccessIterables&&... columns)
+        -> void
+    {
+        detail::sort_columns(sorter, std::forward<RandomAccessIterable>(keys),
+                             std::move(compare), std::move(projection),
+                             std::forward<RandomAccessIterables>(columns)...);
+    }
+}
+
+#endif // CPPSORT_SORT_COLUMNS_H_
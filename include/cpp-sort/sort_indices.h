@@ -0,0 +1,216 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORT_INDICES_H_
+#define CPPSORT_SORT_INDICES_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/size.h>
+#include "detail/apply_permutation.h"
+#include "detail/indirect_compare.h"
+#include "detail/iterator_traits.h"
+#include "detail/memory.h"
+#include "detail/move.h"
+
+namespace cppsort
+{
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Sort indices
+
+        template<typename Sorter, typename IndexIterator,
+                 typename Compare, typename IndexedProjection>
+        auto sort_indices_impl(const Sorter& sorter, IndexIterator first, IndexIterator last,
+                               Compare compare, IndexedProjection projection,
+                               std::true_type /* sorter handles projections */)
+            -> void
+        {
+            sorter(std::move(first), std::move(last),
+                   std::move(compare), std::move(projection));
+        }
+
+        template<typename Sorter, typename IndexIterator,
+                 typename Compare, typename IndexedProjection>
+        auto sort_indices_impl(const Sorter& sorter, IndexIterator first, IndexIterator last,
+                               Compare compare, IndexedProjection projection,
+                               std::false_type /* sorter handles projections */)
+            -> void
+        {
+            // Apply the projection in the comparison function when
+            // the sorter can't handle it directly
+            sorter(std::move(first), std::move(last),
+                   [&compare, &projection](const auto& lhs, const auto& rhs) {
+                       auto&& comp = utility::as_function(compare);
+                       return comp(projection(lhs), projection(rhs));
+                   });
+        }
+
+        template<typename Sorter, typename RandomAccessIterator, typename IndexIterator,
+                 typename Compare, typename Projection>
+        auto sort_indices(const Sorter& sorter,
+                          RandomAccessIterator first, RandomAccessIterator last,
+                          IndexIterator out, Compare compare, Projection projection)
+            -> IndexIterator
+        {
+            using index_t = value_type_t<IndexIterator>;
+            using projection_t = indexed_projection<RandomAccessIterator, Projection>;
+
+            auto size = std::distance(first, last);
+            for (difference_type_t<RandomAccessIterator> i = 0 ; i < size ; ++i) {
+                out[i] = static_cast<index_t>(i);
+            }
+
+            sort_indices_impl(sorter, out, out + size, std::move(compare),
+                              projection_t(std::move(first), std::move(projection)),
+                              std::integral_constant<bool,
+                                  is_comparison_projection_sorter_iterator_v<
+                                      Sorter, IndexIterator, Compare, projection_t
+                                  >
+                              >{});
+            return out + size;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Write the indices of the sorted elements to out
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterator,
+        typename IndexIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+        >
+    >
+    auto sort_indices(const Sorter& sorter,
+                      RandomAccessIterator first, RandomAccessIterator last,
+                      IndexIterator out, Compare compare={}, Projection projection={})
+        -> IndexIterator
+    {
+        return detail::sort_indices(sorter, std::move(first), std::move(last), std::move(out),
+                                    std::move(compare), std::move(projection));
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterator,
+        typename IndexIterator,
+        typename Projection,
+        typename = std::enable_if_t<
+            not is_projection_iterator_v<utility::identity, RandomAccessIterator, Projection> &&
+            is_projection_iterator_v<Projection, RandomAccessIterator>
+        >
+    >
+    auto sort_indices(const Sorter& sorter,
+                      RandomAccessIterator first, RandomAccessIterator last,
+                      IndexIterator out, Projection projection)
+        -> IndexIterator
+    {
+        return detail::sort_indices(sorter, std::move(first), std::move(last), std::move(out),
+                                    std::less<>{}, std::move(projection));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Return the indices of the sorted elements
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_v<Projection, RandomAccessIterable, Compare>
+        >
+    >
+    auto sort_indices(const Sorter& sorter, RandomAccessIterable&& iterable,
+                      Compare compare={}, Projection projection={})
+        -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> indices(utility::size(iterable));
+        detail::sort_indices(sorter, std::begin(iterable), std::end(iterable), indices.begin(),
+                             std::move(compare), std::move(projection));
+        return indices;
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Projection,
+        typename = std::enable_if_t<
+            not is_projection_v<utility::identity, RandomAccessIterable, Projection> &&
+            is_projection_v<Projection, RandomAccessIterable>
+        >
+    >
+    auto sort_indices(const Sorter& sorter, RandomAccessIterable&& iterable,
+                      Projection projection)
+        -> std::vector<std::size_t>
+    {
+        return sort_indices(sorter, std::forward<RandomAccessIterable>(iterable),
+                            std::less<>{}, std::move(projection));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Reorder collections according to indices, throws
+    // std::invalid_argument when the collections don't have
+    // the same size as the indices
+
+    template<typename IndexIterable, typename... RandomAccessIterables>
+    auto apply_permutation(IndexIterable&& indices, RandomAccessIterables&&... collections)
+        -> void
+    {
+        // Check the sizes before touching anything
+        auto size = utility::size(indices);
+        bool sizes_match = true;
+        (void) std::initializer_list<int>{
+            (sizes_match = sizes_match && std::uintmax_t(utility::size(collections)) == std::uintmax_t(size), 0)...
+        };
+        if (not sizes_match) {
+            throw std::invalid_argument("apply_permutation: all the collections must have the same size as the indices");
+        }
+
+        detail::apply_permutation_n(std::begin(indices), size,
+                                    utility::identity{}, std::begin(collections)...);
+    }
+}
+
+#endif // CPPSORT_SORT_INDICES_H_
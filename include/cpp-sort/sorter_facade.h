@@ -86,6 +86,9 @@ namespace cppsort
 
         public:
 
+            // Stateful sorters can be constructed as usual
+            using Sorter::Sorter;
+
             ////////////////////////////////////////////////////////////
             // Conversion to function pointers
 
@@ -32,6 +32,8 @@
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/counting_sort.h"
 #include "../detail/iterator_traits.h"
@@ -79,11 +81,63 @@ namespace cppsort
                 reverse_counting_sort(std::move(first), std::move(last));
             }
 
+            template<
+                typename ForwardIterator,
+                typename Projection,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Projection projection) const
+                -> std::enable_if_t<std::is_integral<
+                    std::decay_t<decltype(utility::as_function(projection)(*first))>
+                >::value>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::forward_iterator_tag,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "counting_sorter requires at least forward iterators"
+                );
+
+                stable_counting_sort(std::move(first), std::move(last),
+                                     std::less<>{}, std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Projection,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, std::greater<>>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            std::greater<> compare, Projection projection) const
+                -> std::enable_if_t<std::is_integral<
+                    std::decay_t<decltype(utility::as_function(projection)(*first))>
+                >::value>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::forward_iterator_tag,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "counting_sorter requires at least forward iterators"
+                );
+
+                stable_counting_sort(std::move(first), std::move(last),
+                                     compare, std::move(projection));
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
+            // Equal integers can't be told apart, and the elements
+            // with equal keys keep their order with a projection
             using iterator_category = std::forward_iterator_tag;
-            using is_always_stable = std::false_type;
+            using is_always_stable = std::true_type;
         };
     }
 
@@ -37,6 +37,7 @@
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/drop_merge_sort.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -45,8 +46,11 @@ namespace cppsort
 
     namespace detail
     {
-        struct drop_merge_sorter_impl
+        struct drop_merge_sorter_impl:
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<
                 typename BidirectionalIterator,
                 typename Compare = std::less<>,
@@ -68,7 +72,8 @@ namespace cppsort
                 );
 
                 drop_merge_sort(std::move(first), std::move(last),
-                                std::move(compare), std::move(projection));
+                                std::move(compare), std::move(projection),
+                                resource());
             }
 
             ////////////////////////////////////////////////////////////
@@ -81,7 +86,9 @@ namespace cppsort
 
     struct drop_merge_sorter:
         sorter_facade<detail::drop_merge_sorter_impl>
-    {};
+    {
+        using sorter_facade<detail::drop_merge_sorter_impl>::sorter_facade;
+    };
 
     ////////////////////////////////////////////////////////////
     // Sort function
@@ -36,6 +36,7 @@
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/merge_insertion_sort.h"
 
 namespace cppsort
@@ -45,8 +46,11 @@ namespace cppsort
 
     namespace detail
     {
-        struct merge_insertion_sorter_impl
+        struct merge_insertion_sorter_impl:
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<
                 typename RandomAccessIterator,
                 typename Compare = std::less<>,
@@ -68,7 +72,8 @@ namespace cppsort
                 );
 
                 merge_insertion_sort(std::move(first), std::move(last),
-                                     std::move(compare), std::move(projection));
+                                     std::move(compare), std::move(projection),
+                                     resource());
             }
 
             ////////////////////////////////////////////////////////////
@@ -81,7 +86,9 @@ namespace cppsort
 
     struct merge_insertion_sorter:
         sorter_facade<detail::merge_insertion_sorter_impl>
-    {};
+    {
+        using sorter_facade<detail::merge_insertion_sorter_impl>::sorter_facade;
+    };
 
     ////////////////////////////////////////////////////////////
     // Sort function
@@ -46,8 +46,11 @@ namespace cppsort
 
     namespace detail
     {
-        struct merge_sorter_impl
+        struct merge_sorter_impl:
+            uses_memory_resource
         {
+            using uses_memory_resource::uses_memory_resource;
+
             template<
                 typename ForwardIterable,
                 typename Compare = std::less<>,
@@ -70,7 +73,8 @@ namespace cppsort
 
                 merge_sort(std::begin(iterable), std::end(iterable),
                            utility::size(iterable),
-                           std::move(compare), std::move(projection));
+                           std::move(compare), std::move(projection),
+                           resource());
             }
 
             template<
@@ -95,7 +99,8 @@ namespace cppsort
 
                 auto dist = std::distance(first, last);
                 merge_sort(std::move(first), std::move(last), dist,
-                           std::move(compare), std::move(projection));
+                           std::move(compare), std::move(projection),
+                           resource());
             }
 
             ////////////////////////////////////////////////////////////
@@ -108,7 +113,9 @@ namespace cppsort
 
     struct merge_sorter:
         sorter_facade<detail::merge_sorter_impl>
-    {};
+    {
+        using sorter_facade<detail::merge_sorter_impl>::sorter_facade;
+    };
 
     ////////////////////////////////////////////////////////////
     // Sort function
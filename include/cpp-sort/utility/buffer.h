@@ -29,7 +29,10 @@
 ////////////////////////////////////////////////////////////
 #include <array>
 #include <cstddef>
+#include <limits>
 #include <memory>
+#include <utility>
+#include "../detail/bitops.h"
 
 namespace cppsort
 {
@@ -185,6 +188,185 @@ namespace utility
                 }
         };
     };
+
+    ////////////////////////////////////////////////////////////
+    // Dynamic buffer backed by a thread-local cache
+
+    namespace detail
+    {
+        // Pool of buffers of T kept around by a thread between two
+        // sorts; buffers are sorted in power of 2 size classes and a
+        // few of them are kept for every class
+        template<typename T>
+        class buffer_cache
+        {
+            public:
+
+                static constexpr std::size_t buffers_per_class = 2;
+
+                static auto instance()
+                    -> buffer_cache&
+                {
+                    static thread_local buffer_cache cache;
+                    return cache;
+                }
+
+                // Returns a buffer of at least size elements, updating
+                // size to the real capacity of the buffer
+                auto acquire(std::size_t& size)
+                    -> std::unique_ptr<T[]>
+                {
+                    auto size_class = class_of(size);
+                    size = std::size_t(1) << size_class;
+
+                    auto& count = _count[size_class];
+                    if (count == 0) {
+                        return std::make_unique<T[]>(size);
+                    }
+                    return std::move(_buffers[size_class][--count]);
+                }
+
+                // Gives a buffer acquired with the given capacity back to
+                // the cache, the buffer is freed if the cache is full
+                auto release(std::unique_ptr<T[]>&& memory, std::size_t capacity)
+                    -> void
+                {
+                    auto size_class = class_of(capacity);
+                    auto& count = _count[size_class];
+                    if (count < buffers_per_class) {
+                        _buffers[size_class][count++] = std::move(memory);
+                    } else {
+                        memory.reset();
+                    }
+                }
+
+                auto clear()
+                    -> void
+                {
+                    for (std::size_t i = 0 ; i < number_of_classes ; ++i) {
+                        for (std::size_t j = 0 ; j < _count[i] ; ++j) {
+                            _buffers[i][j].reset();
+                        }
+                        _count[i] = 0;
+                    }
+                }
+
+            private:
+
+                static constexpr std::size_t number_of_classes =
+                    std::numeric_limits<std::size_t>::digits;
+
+                static auto class_of(std::size_t size)
+                    -> std::size_t
+                {
+                    // Smallest n such as 2^n >= size
+                    if (size <= 1) return 0;
+                    return cppsort::detail::log2(size - 1) + 1;
+                }
+
+                buffer_cache() = default;
+
+                std::unique_ptr<T[]> _buffers[number_of_classes][buffers_per_class];
+                std::size_t _count[number_of_classes] = {};
+        };
+    }
+
+    template<typename SizePolicy>
+    struct cached_buffer
+    {
+        template<typename T>
+        class buffer
+        {
+            private:
+
+                std::size_t _size;
+                std::size_t _capacity;
+                std::unique_ptr<T[]> _memory;
+
+            public:
+
+                explicit buffer(std::size_t size):
+                    _size(SizePolicy{}(size)),
+                    _capacity(_size)
+                {
+                    if (_size > 0) {
+                        _memory = detail::buffer_cache<T>::instance().acquire(_capacity);
+                    }
+                }
+
+                buffer(const buffer&) = delete;
+                buffer& operator=(const buffer&) = delete;
+
+                ~buffer()
+                {
+                    if (_memory) {
+                        detail::buffer_cache<T>::instance().release(std::move(_memory), _capacity);
+                    }
+                }
+
+                auto size() const
+                    -> std::size_t
+                {
+                    return _size;
+                }
+
+                auto operator[](std::size_t pos)
+                    -> decltype(_memory[pos])
+                {
+                    return _memory[pos];
+                }
+
+                auto operator[](std::size_t pos) const
+                    -> decltype(_memory[pos])
+                {
+                    return _memory[pos];
+                }
+
+                auto begin()
+                    -> decltype(_memory.get())
+                {
+                    return _memory.get();
+                }
+
+                auto begin() const
+                    -> decltype(_memory.get())
+                {
+                    return _memory.get();
+                }
+
+                auto cbegin() const
+                    -> decltype(_memory.get())
+                {
+                    return _memory.get();
+                }
+
+                auto end()
+                    -> decltype(_memory.get() + size())
+                {
+                    return _memory.get() + size();
+                }
+
+                auto end() const
+                    -> decltype(_memory.get() + size())
+                {
+                    return _memory.get() + size();
+                }
+
+                auto cend() const
+                    -> decltype(_memory.get() + size())
+                {
+                    return _memory.get() + size();
+                }
+        };
+
+        // Frees the buffers of T cached by the calling thread
+        template<typename T>
+        static auto clear_cache()
+            -> void
+        {
+            detail::buffer_cache<T>::instance().clear();
+        }
+    };
 }}
 
 #endif // CPPSORT_UTILITY_BUFFER_H_
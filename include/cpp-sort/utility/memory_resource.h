@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_MEMORY_RESOURCE_H_
+#define CPPSORT_UTILITY_MEMORY_RESOURCE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <new>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Memory resource
+    //
+    // Abstract interface for the classes that sorters can use
+    // to allocate their temporary buffers, modeled after the
+    // C++17 std::pmr::memory_resource. Sorters that accept a
+    // memory resource fall back to their default allocation
+    // strategy when they are given a null pointer.
+
+    class memory_resource
+    {
+        public:
+
+            virtual ~memory_resource() = default;
+
+            auto allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t))
+                -> void*
+            {
+                return do_allocate(bytes, alignment);
+            }
+
+            auto deallocate(void* pointer, std::size_t bytes,
+                            std::size_t alignment=alignof(std::max_align_t))
+                -> void
+            {
+                do_deallocate(pointer, bytes, alignment);
+            }
+
+            auto is_equal(const memory_resource& other) const noexcept
+                -> bool
+            {
+                return do_is_equal(other);
+            }
+
+        private:
+
+            virtual auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* = 0;
+            virtual auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                -> void = 0;
+            virtual auto do_is_equal(const memory_resource& other) const noexcept
+                -> bool = 0;
+    };
+
+    inline auto operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+        -> bool
+    {
+        return &lhs == &rhs || lhs.is_equal(rhs);
+    }
+
+    inline auto operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+        -> bool
+    {
+        return not (lhs == rhs);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Resource using the global operator new and operator delete
+
+    namespace detail
+    {
+        class new_delete_resource_impl:
+            public memory_resource
+        {
+            private:
+
+                auto do_allocate(std::size_t bytes, std::size_t)
+                    -> void* override
+                {
+                    return ::operator new(bytes);
+                }
+
+                auto do_deallocate(void* pointer, std::size_t, std::size_t)
+                    -> void override
+                {
+                    ::operator delete(pointer);
+                }
+
+                auto do_is_equal(const memory_resource& other) const noexcept
+                    -> bool override
+                {
+                    return this == &other;
+                }
+        };
+    }
+
+    inline auto new_delete_resource() noexcept
+        -> memory_resource*
+    {
+        static detail::new_delete_resource_impl resource;
+        return &resource;
+    }
+}}
+
+#endif // CPPSORT_UTILITY_MEMORY_RESOURCE_H_
@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_SORT_WORKSPACE_H_
+#define CPPSORT_UTILITY_SORT_WORKSPACE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <cpp-sort/utility/memory_resource.h>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Reusable scratch memory for sorters
+    //
+    // Memory resource meant to be given to sorters accepting
+    // one in order to reuse the same memory across sorts. It
+    // owns a single block of memory from which allocations are
+    // carved; when that block is too small, the missing memory
+    // is temporarily taken from the upstream resource, and the
+    // block grows to the size that was needed the next time it
+    // is used with no memory allocated, which typically happens
+    // at the beginning of the next sort. Sorts of a similar size
+    // then don't have to allocate memory at all.
+    //
+    // A workspace must not be used by several threads at once.
+
+    class sort_workspace:
+        public memory_resource
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction & destruction
+
+            explicit sort_workspace(memory_resource* upstream=new_delete_resource()) noexcept:
+                _upstream(upstream)
+            {}
+
+            explicit sort_workspace(std::size_t capacity,
+                                    memory_resource* upstream=new_delete_resource()):
+                _upstream(upstream)
+            {
+                reserve(capacity);
+            }
+
+            sort_workspace(const sort_workspace&) = delete;
+            sort_workspace& operator=(const sort_workspace&) = delete;
+
+            ~sort_workspace()
+            {
+                release();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            // Size of the reusable block of memory
+            auto capacity() const noexcept
+                -> std::size_t
+            {
+                return _capacity;
+            }
+
+            auto upstream_resource() const noexcept
+                -> memory_resource*
+            {
+                return _upstream;
+            }
+
+            // Grows the reusable block to at least the given size,
+            // must not be called while memory is still allocated
+            auto reserve(std::size_t capacity)
+                -> void
+            {
+                if (capacity <= _capacity) return;
+                release();
+                _memory = static_cast<char*>(_upstream->allocate(capacity));
+                _capacity = capacity;
+                _required = std::max(_required, capacity);
+            }
+
+            // Gives the reusable block back to the upstream resource,
+            // must not be called while memory is still allocated
+            auto release() noexcept
+                -> void
+            {
+                if (_memory) {
+                    _upstream->deallocate(_memory, _capacity);
+                    _memory = nullptr;
+                    _capacity = 0;
+                    _used = 0;
+                }
+            }
+
+        private:
+
+            ////////////////////////////////////////////////////////////
+            // Memory resource interface
+
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                bytes = std::max(bytes, std::size_t(1));
+                if (_nb_allocations == 0) {
+                    // Nothing is allocated: make the block big enough
+                    // for what was needed at once until now, growing
+                    // geometrically to avoid reallocating it too often
+                    _used = 0;
+                    if (_required > _capacity) {
+                        reserve(std::max(_required, 2 * _capacity));
+                    }
+                }
+
+                // Try to carve the memory from the reusable block
+                if (_memory) {
+                    auto address = reinterpret_cast<std::uintptr_t>(_memory);
+                    auto start = (address + _used + alignment - 1) / alignment * alignment - address;
+                    if (start + bytes <= _capacity) {
+                        _used = start + bytes;
+                        _required = std::max(_required, _used + _borrowed);
+                        ++_nb_allocations;
+                        return _memory + start;
+                    }
+                }
+
+                // Borrow memory from the upstream resource
+                void* pointer = _upstream->allocate(bytes, alignment);
+                _borrowed += bytes + alignment;
+                _required = std::max(_required, _used + _borrowed);
+                ++_nb_allocations;
+                return pointer;
+            }
+
+            auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                -> void override
+            {
+                bytes = std::max(bytes, std::size_t(1));
+                char* ptr = static_cast<char*>(pointer);
+                if (_memory && not std::less<char*>{}(ptr, _memory)
+                            && std::less<char*>{}(ptr, _memory + _capacity)) {
+                    // Reclaim the memory if it was the last allocation
+                    if (ptr + bytes == _memory + _used) {
+                        _used = ptr - _memory;
+                    }
+                } else {
+                    _upstream->deallocate(pointer, bytes, alignment);
+                    _borrowed -= bytes + alignment;
+                }
+
+                --_nb_allocations;
+            }
+
+            auto do_is_equal(const memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Data members
+
+            // Resource providing the actual memory
+            memory_resource* _upstream;
+
+            // Reusable block of memory
+            char* _memory = nullptr;
+            std::size_t _capacity = 0;
+            std::size_t _used = 0;
+
+            // Memory currently borrowed from the upstream resource
+            std::size_t _borrowed = 0;
+
+            // Biggest amount of memory needed at once so far
+            std::size_t _required = 0;
+
+            // Number of live allocations
+            std::size_t _nb_allocations = 0;
+    };
+}}
+
+#endif // CPPSORT_UTILITY_SORT_WORKSPACE_H_
@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/adapters/instrumented_adapter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/counting_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/selection_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/sorter_traits.h>
+#include "../algorithm.h"
+#include "../distributions.h"
+
+TEST_CASE( "basic instrumented_adapter tests",
+           "[instrumented_adapter][selection_sorter]" )
+{
+    // Selection sort always makes the same number of comparisons
+    // for a given size of arrays, allowing to deterministically
+    // check that number of comparisons
+    cppsort::sort_statistics stats;
+    cppsort::instrumented_adapter<cppsort::selection_sorter> sorter(stats);
+
+    SECTION( "without projections" )
+    {
+        std::list<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 65, 0);
+
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( stats.sorts == 1 );
+        CHECK( stats.elements == 65 );
+        CHECK( stats.comparisons == 2080 );
+        CHECK( stats.projections == 0 );
+        CHECK( stats.allocations == 0 );
+        CHECK( stats.bytes_allocated == 0 );
+    }
+
+    SECTION( "with projections" )
+    {
+        struct wrapper { int value; };
+
+        // Pseudo-random number engine
+        std::mt19937_64 engine(Catch::rngSeed());
+
+        std::vector<wrapper> collection(80);
+        helpers::iota(std::begin(collection), std::end(collection), 0, &wrapper::value);
+        std::shuffle(std::begin(collection), std::end(collection), engine);
+
+        cppsort::sort(sorter, collection, &wrapper::value);
+        CHECK( helpers::is_sorted(std::begin(collection), std::end(collection),
+                                  std::less<>{}, &wrapper::value) );
+        CHECK( stats.comparisons == 3160 );
+        CHECK( stats.projections == 2 * 3160 );
+        CHECK( stats.swaps > 0 );
+    }
+}
+
+TEST_CASE( "instrumented_adapter statistics",
+           "[instrumented_adapter][merge_sorter]" )
+{
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000, 0);
+
+    cppsort::sort_statistics stats;
+
+    SECTION( "allocations through the memory resource" )
+    {
+        cppsort::instrumented_adapter<cppsort::merge_sorter> sorter(stats);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( stats.allocations > 0 );
+        CHECK( stats.bytes_allocated >= 500 * sizeof(int) );
+        CHECK( stats.moves > 0 );
+        CHECK( stats.comparisons > 0 );
+    }
+
+    SECTION( "accumulate and reset" )
+    {
+        cppsort::instrumented_adapter<cppsort::pdq_sorter> sorter(stats);
+        auto copy = collection;
+        cppsort::sort(sorter, collection);
+        auto comparisons = stats.comparisons.load();
+        cppsort::sort(sorter, copy);
+        CHECK( collection == copy );
+        CHECK( stats.sorts == 2 );
+        CHECK( stats.elements == 2000 );
+        CHECK( stats.comparisons > comparisons );
+
+        stats.reset();
+        CHECK( stats.sorts == 0 );
+        CHECK( stats.comparisons == 0 );
+        CHECK( stats.nanoseconds == 0 );
+    }
+
+    SECTION( "throwing comparison" )
+    {
+        cppsort::instrumented_adapter<cppsort::pdq_sorter> sorter(stats);
+        int nb_comparisons = 0;
+        auto throwing_less = [&nb_comparisons](int lhs, int rhs) {
+            if (++nb_comparisons == 100) {
+                throw std::runtime_error("comparison failed");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS( cppsort::sort(sorter, collection, throwing_less), std::runtime_error );
+        CHECK( stats.sorts == 1 );
+        CHECK( stats.elements == 1000 );
+        CHECK( stats.comparisons == 100 );
+        CHECK( stats.nanoseconds > 0 );
+    }
+
+    SECTION( "parallel sorter" )
+    {
+        std::vector<int> big; big.reserve(100'000);
+        distribution(std::back_inserter(big), 100'000, 0);
+
+        cppsort::instrumented_adapter<cppsort::parallel_merge_sorter> sorter(stats);
+        cppsort::sort(sorter, big);
+        CHECK( std::is_sorted(std::begin(big), std::end(big)) );
+        CHECK( stats.comparisons >= 100'000 / 2 );
+    }
+}
+
+TEST_CASE( "instrumented_adapter over non-comparison sorters",
+           "[instrumented_adapter][ska_sorter][spread_sorter][counting_sorter]" )
+{
+    using ska_adapter = cppsort::instrumented_adapter<cppsort::ska_sorter>;
+
+    // The standard comparisons are passed unwrapped to the radix
+    // sorters, arbitrary comparisons aren't accepted at all
+    auto greater_than = [](int lhs, int rhs) { return lhs > rhs; };
+    CHECK( cppsort::is_sorter_v<ska_adapter, std::vector<int>&> );
+    CHECK( cppsort::is_projection_v<std::negate<>, std::vector<int>&> );
+    CHECK( cppsort::is_projection_sorter_v<ska_adapter, std::vector<int>&, std::negate<>> );
+    CHECK_FALSE( cppsort::is_comparison_sorter_v<ska_adapter, std::vector<int>&,
+                                                 decltype(greater_than)> );
+
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000, -500);
+
+    cppsort::sort_statistics stats;
+
+    SECTION( "ska_sorter" )
+    {
+        ska_adapter sorter(stats);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( stats.sorts == 1 );
+        CHECK( stats.comparisons == 0 );
+
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( stats.projections >= 1000 );
+    }
+
+    SECTION( "spread_sorter" )
+    {
+        cppsort::instrumented_adapter<cppsort::spread_sorter> sorter(stats);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( stats.sorts == 1 );
+    }
+
+    SECTION( "counting_sorter" )
+    {
+        cppsort::instrumented_adapter<cppsort::counting_sorter> sorter(stats);
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( stats.sorts == 1 );
+    }
+}
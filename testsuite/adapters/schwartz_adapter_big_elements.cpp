@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include "../algorithm.h"
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int position;
+        std::string payload;
+    };
+
+    auto make_records(std::size_t size, int different_keys)
+        -> std::vector<record>
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> dist(0, different_keys - 1);
+
+        std::vector<record> res;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            int key = dist(engine);
+            res.push_back({ key, int(i), std::to_string(key) + std::string(20, 'x') });
+        }
+        return res;
+    }
+}
+
+TEST_CASE( "Schwartzian transform adapter with big elements",
+           "[schwartz_adapter]" )
+{
+    SECTION( "elements are moved with their keys" )
+    {
+        auto collection = make_records(1000, 1000);
+        std::size_t calls = 0;
+        auto projection = [&calls](const record& rec) {
+            ++calls;
+            return rec.key;
+        };
+
+        cppsort::sort(cppsort::schwartz_adapter<cppsort::pdq_sorter>{},
+                      collection, projection);
+        CHECK( calls == collection.size() );
+        CHECK( helpers::is_sorted(std::begin(collection), std::end(collection),
+                                  std::less<>{}, &record::key) );
+        for (const auto& rec: collection) {
+            CHECK( rec.payload == std::to_string(rec.key) + std::string(20, 'x') );
+        }
+    }
+
+    SECTION( "stability is preserved" )
+    {
+        auto collection = make_records(1000, 10);
+        cppsort::sort(cppsort::schwartz_adapter<cppsort::merge_sorter>{},
+                      collection, &record::key);
+
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                              [](const record& lhs, const record& rhs) {
+                                  if (lhs.key != rhs.key) {
+                                      return lhs.key < rhs.key;
+                                  }
+                                  return lhs.position < rhs.position;
+                              }) );
+    }
+
+    SECTION( "non random-access iterators" )
+    {
+        auto records = make_records(500, 100);
+        std::list<record> collection(std::begin(records), std::end(records));
+        cppsort::sort(cppsort::schwartz_adapter<cppsort::merge_sorter>{},
+                      collection, &record::key);
+        CHECK( helpers::is_sorted(std::begin(collection), std::end(collection),
+                                  std::less<>{}, &record::key) );
+    }
+}
@@ -21,13 +21,20 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <iterator>
 #include <locale>
+#include <random>
 #include <string>
+#include <vector>
 #include <catch.hpp>
+#include <cpp-sort/adapters/schwartz_adapter.h>
 #include <cpp-sort/comparators/case_insensitive_less.h>
 #include <cpp-sort/refined.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/spread_sorter.h>
 
 namespace sub
 {
@@ -114,3 +121,63 @@ TEST_CASE( "case-insensitive string comparison with case_insensitive_less" )
     }
 }
 
+
+TEST_CASE( "case_insensitive_less with long strings" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    // Strings long enough to be compared 8 characters at a time,
+    // with characters around the letters and outside of ASCII
+    const std::string alphabet = "@AZ[`az{aZ-\xc9\xe9";
+    std::uniform_int_distribution<std::size_t> char_dist(0, alphabet.size() - 1);
+    std::uniform_int_distribution<std::size_t> size_dist(0, 20);
+
+    std::vector<std::string> vec;
+    for (int i = 0 ; i < 1000 ; ++i) {
+        std::string str = "Some-Common-PREFIX-";
+        auto size = size_dist(engine);
+        for (std::size_t j = 0 ; j < size ; ++j) {
+            str.push_back(alphabet[char_dist(engine)]);
+        }
+        vec.push_back(str);
+    }
+
+    // Reference implementation with the classic locale facet
+    const auto& ct = std::use_facet<std::ctype<char>>(std::locale::classic());
+    auto reference_less = [&](const std::string& lhs, const std::string& rhs) {
+        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
+                                            std::begin(rhs), std::end(rhs),
+                                            [&](char lhs, char rhs) {
+                                                return ct.tolower(lhs) < ct.tolower(rhs);
+                                            });
+    };
+
+    SECTION( "ASCII fast path" )
+    {
+        auto compare = cppsort::case_insensitive_less(std::locale::classic());
+        auto refined = cppsort::refined<std::string>(cppsort::case_insensitive_less);
+        for (std::size_t i = 0 ; i + 1 < vec.size() ; ++i) {
+            auto& lhs = vec[i];
+            auto& rhs = vec[i + 1];
+            CHECK( compare(lhs, rhs) == reference_less(lhs, rhs) );
+            CHECK( compare(rhs, lhs) == reference_less(rhs, lhs) );
+            CHECK( refined(lhs, rhs) == reference_less(lhs, rhs) );
+        }
+    }
+
+    SECTION( "case-folded keys" )
+    {
+        auto key = cppsort::case_insensitive_key(std::locale::classic());
+        for (std::size_t i = 0 ; i + 1 < vec.size() ; ++i) {
+            auto& lhs = vec[i];
+            auto& rhs = vec[i + 1];
+            CHECK( (key(lhs) < key(rhs)) == reference_less(lhs, rhs) );
+            CHECK( (key(rhs) < key(lhs)) == reference_less(rhs, lhs) );
+        }
+
+        cppsort::sort(cppsort::schwartz_adapter<cppsort::spread_sorter>{}, vec,
+                      cppsort::case_insensitive_key);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), reference_less) );
+    }
+}
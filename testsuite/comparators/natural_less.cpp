@@ -21,11 +21,18 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <iterator>
+#include <random>
 #include <string>
+#include <vector>
 #include <catch.hpp>
+#include <cpp-sort/adapters/schwartz_adapter.h>
 #include <cpp-sort/comparators/natural_less.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/string_prefix_sorter.h>
 
 TEST_CASE( "string natural sort with natural_less" )
 {
@@ -52,3 +59,55 @@ TEST_CASE( "string natural sort with natural_less" )
     CHECK( array == expected );
 }
 
+
+TEST_CASE( "natural_less corner cases" )
+{
+    // Numbers followed by more characters
+    CHECK( cppsort::natural_less(std::string("a1"), std::string("a1b")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a1b"), std::string("a1")) );
+    CHECK( cppsort::natural_less(std::string("a2b"), std::string("a10a")) );
+
+    // Numbers made only of zeros don't end the comparison
+    CHECK( cppsort::natural_less(std::string("a0b"), std::string("a00c")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a00c"), std::string("a0b")) );
+
+    // Mismatch after a long common prefix, inside a number
+    std::string prefix = "/some/long/common/directory/file-";
+    CHECK( cppsort::natural_less(prefix + "9.txt", prefix + "10.txt") );
+    CHECK( cppsort::natural_less(prefix + "0123.txt", prefix + "124.txt") );
+    CHECK_FALSE( cppsort::natural_less(prefix + "124.txt", prefix + "0123.txt") );
+}
+
+TEST_CASE( "natural_key consistency with natural_less" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    // Small alphabet to get plenty of numbers and common prefixes
+    const std::string alphabet = "ab-.0019\xe9";
+    std::uniform_int_distribution<std::size_t> char_dist(0, alphabet.size() - 1);
+    std::uniform_int_distribution<std::size_t> size_dist(0, 12);
+
+    std::vector<std::string> vec;
+    for (int i = 0 ; i < 1000 ; ++i) {
+        std::string str;
+        auto size = size_dist(engine);
+        for (std::size_t j = 0 ; j < size ; ++j) {
+            str.push_back(alphabet[char_dist(engine)]);
+        }
+        vec.push_back(str);
+    }
+
+    for (std::size_t i = 0 ; i + 1 < vec.size() ; ++i) {
+        auto& lhs = vec[i];
+        auto& rhs = vec[i + 1];
+        CHECK( cppsort::natural_less(lhs, rhs) == (cppsort::natural_key(lhs) < cppsort::natural_key(rhs)) );
+        CHECK( cppsort::natural_less(rhs, lhs) == (cppsort::natural_key(rhs) < cppsort::natural_key(lhs)) );
+    }
+
+    SECTION( "sort with schwartz_adapter" )
+    {
+        cppsort::sort(cppsort::schwartz_adapter<cppsort::string_prefix_sorter>{}, vec, cppsort::natural_key);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), cppsort::natural_less) );
+    }
+}
@@ -42,6 +42,12 @@ TEST_CASE( "test every sorter", "[sorters]" )
     auto distribution = dist::shuffled{};
     distribution(std::back_inserter(collection), 491, -125);
 
+    SECTION( "adaptive_sorter" )
+    {
+        cppsort::sort(cppsort::adaptive_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "block_sorter" )
     {
         using namespace cppsort;
@@ -53,6 +59,10 @@ TEST_CASE( "test every sorter", "[sorters]" )
         // Dynamic buffer
         sort(block_sorter<utility::dynamic_buffer<utility::sqrt>>{}, collection);
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+
+        // Cached buffer
+        sort(block_sorter<utility::cached_buffer<utility::sqrt>>{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
     SECTION( "counting_sorter" )
@@ -84,6 +94,10 @@ TEST_CASE( "test every sorter", "[sorters]" )
         // Dynamic buffer
         sort(grail_sorter<utility::dynamic_buffer<utility::half>>{}, collection);
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+
+        // Cached buffer
+        sort(grail_sorter<utility::cached_buffer<utility::half>>{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
     SECTION( "heap_sorter" )
@@ -110,6 +124,30 @@ TEST_CASE( "test every sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "parallel_counting_sorter" )
+    {
+        cppsort::sort(cppsort::parallel_counting_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_merge_sorter" )
+    {
+        cppsort::sort(cppsort::parallel_merge_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_pdq_sorter" )
+    {
+        cppsort::sort(cppsort::parallel_pdq_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_ska_sorter" )
+    {
+        cppsort::sort(cppsort::parallel_ska_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "pdq_sorter" )
     {
         cppsort::sort(cppsort::pdq_sorter{}, collection);
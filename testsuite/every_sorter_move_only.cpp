@@ -46,6 +46,12 @@ TEST_CASE( "test every sorter with move-only types", "[sorters]" )
     std::mt19937 engine(Catch::rngSeed());
     std::shuffle(std::begin(collection), std::end(collection), engine);
 
+    SECTION( "adaptive_sorter" )
+    {
+        cppsort::sort(cppsort::adaptive_sorter{}, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "block_sorter" )
     {
         sort(cppsort::block_sorter<cppsort::utility::fixed_buffer<0>>{}, collection);
@@ -45,6 +45,12 @@ TEST_CASE( "test every sorter with no_post_iterator", "[sorters]" )
     auto first = make_no_post_iterator(std::begin(collection));
     auto last = make_no_post_iterator(std::end(collection));
 
+    SECTION( "adaptive_sorter" )
+    {
+        cppsort::sort(cppsort::adaptive_sorter{}, first, last);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "block_sorter" )
     {
         sort(cppsort::block_sorter<cppsort::utility::fixed_buffer<0>>{}, first, last);
@@ -43,6 +43,12 @@ TEST_CASE( "test every sorter with temporary span",
     auto distribution = dist::shuffled{};
     distribution(std::back_inserter(collection), 491, -125);
 
+    SECTION( "adaptive_sorter" )
+    {
+        cppsort::sort(cppsort::adaptive_sorter{}, make_span(collection));
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "block_sorter" )
     {
         using namespace cppsort;
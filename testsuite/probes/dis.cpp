@@ -21,8 +21,13 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
+#include <cstddef>
 #include <forward_list>
+#include <functional>
 #include <iterator>
+#include <random>
+#include <vector>
 #include <catch.hpp>
 #include <cpp-sort/probes/dis.h>
 
@@ -51,4 +56,49 @@ TEST_CASE( "presortedness measure: dis", "[probe][dis]" )
         CHECK( cppsort::probe::dis(li) == 10 );
         CHECK( cppsort::probe::dis(std::begin(li), std::end(li)) == 10 );
     }
+
+    SECTION( "comparison with the naive algorithm" )
+    {
+        // Maximum distance between the elements of an inversion,
+        // computed by checking every pair of elements
+        auto naive_dis = [](const std::vector<int>& vec) {
+            std::ptrdiff_t max_dist = 0;
+            for (std::size_t i = 0 ; i < vec.size() ; ++i) {
+                for (std::size_t j = i + 1 ; j < vec.size() ; ++j) {
+                    if (vec[j] < vec[i]) {
+                        max_dist = std::max(max_dist, std::ptrdiff_t(j - i));
+                    }
+                }
+            }
+            return max_dist;
+        };
+
+        std::mt19937 engine(Catch::rngSeed());
+        for (int size: { 2, 3, 10, 57, 300 }) {
+            for (int max_value: { 1, 8, 1000 }) {
+                std::uniform_int_distribution<int> dist(0, max_value);
+                std::vector<int> vec;
+                for (int i = 0 ; i < size ; ++i) {
+                    vec.push_back(dist(engine));
+                }
+
+                std::forward_list<int> li(std::begin(vec), std::end(vec));
+                CHECK( cppsort::probe::dis(vec) == naive_dis(vec) );
+                CHECK( cppsort::probe::dis(li) == naive_dis(vec) );
+
+                auto reversed = vec;
+                std::reverse(std::begin(reversed), std::end(reversed));
+                CHECK( cppsort::probe::dis(vec, std::greater<>{}) == naive_dis(reversed) );
+            }
+        }
+    }
+
+    SECTION( "with projection" )
+    {
+        struct wrapper { int value; };
+        std::vector<wrapper> vec = {
+            {47}, {53}, {46}, {41}, {59}, {81}, {74}, {97}, {100}, {45}
+        };
+        CHECK( cppsort::probe::dis(vec, &wrapper::value) == 9 );
+    }
 }
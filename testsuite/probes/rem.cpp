@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #include <forward_list>
+#include <functional>
 #include <iterator>
 #include <catch.hpp>
 #include <cpp-sort/probes/rem.h>
@@ -62,4 +63,14 @@ TEST_CASE( "presortedness measure: rem", "[probe][rem]" )
         CHECK( cppsort::probe::rem(li) == 0 );
         CHECK( cppsort::probe::rem(std::begin(li), std::end(li)) == 0 );
     }
+
+    SECTION( "with projection" )
+    {
+        struct wrapper { int value; };
+        std::forward_list<wrapper> li = {
+            {6}, {9}, {79}, {41}, {44}, {49}, {11}, {16}, {69}, {15}
+        };
+        CHECK( cppsort::probe::rem(li, &wrapper::value) == 4 );
+        CHECK( cppsort::probe::rem(li, std::greater<>{}, &wrapper::value) == 6 );
+    }
 }
@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/sampled_inv.h>
+#include "../distributions.h"
+
+TEST_CASE( "approximate presortedness measure: inv", "[probe][sampled_inv]" )
+{
+    SECTION( "small collections are measured exactly" )
+    {
+        std::forward_list<int> li = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+        CHECK( cppsort::probe::sampled_inv(li) == 19 );
+        CHECK( cppsort::probe::sampled_inv(std::begin(li), std::end(li)) == 19 );
+    }
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    dist::shuffled{}(std::back_inserter(collection), 100'000, 0);
+    auto max_inv = 100'000ll * 99'999ll / 2;
+
+    SECTION( "bounds" )
+    {
+        std::sort(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_inv(collection) == 0 );
+        std::reverse(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_inv(collection) == max_inv );
+    }
+
+    SECTION( "estimate with random-access iterators" )
+    {
+        // Half the elements are shuffled
+        std::sort(std::begin(collection), std::begin(collection) + 50'000);
+        auto exact = cppsort::probe::inv(collection);
+        auto estimate = cppsort::probe::sampled_inv(collection);
+        CHECK( std::abs(estimate - exact) <= max_inv / 20 );
+
+        auto estimate_greater = cppsort::probe::sampled_inv(collection, std::greater<>{});
+        CHECK( std::abs(estimate_greater - (max_inv - exact)) <= max_inv / 20 );
+    }
+
+    SECTION( "estimate with forward iterators" )
+    {
+        std::sort(std::begin(collection) + 50'000, std::end(collection));
+        std::forward_list<int> li(std::begin(collection), std::end(collection));
+        auto exact = cppsort::probe::inv(li);
+        auto estimate = cppsort::probe::sampled_inv(li);
+        CHECK( std::abs(estimate - exact) <= max_inv / 20 );
+    }
+
+    SECTION( "custom sample size and seed" )
+    {
+        struct wrapper { int value; };
+        std::vector<wrapper> wrappers;
+        for (int value: collection) {
+            wrappers.push_back({value});
+        }
+        auto exact = cppsort::probe::inv(collection);
+        auto estimate = cppsort::probe::sampled_inv_probe(16'384, 42)(wrappers, &wrapper::value);
+        CHECK( std::abs(estimate - exact) <= max_inv / 50 );
+    }
+
+    SECTION( "degenerate sample sizes" )
+    {
+        // Clamped to the smallest sample that can be scaled
+        std::sort(std::begin(collection), std::end(collection), std::greater<>{});
+        CHECK( cppsort::probe::sampled_inv_probe(0)(collection) == max_inv );
+        CHECK( cppsort::probe::sampled_inv_probe(1)(collection) == max_inv );
+        std::sort(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_inv_probe(-5)(collection) == 0 );
+    }
+}
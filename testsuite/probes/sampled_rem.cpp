@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <forward_list>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/probes/sampled_rem.h>
+#include "../distributions.h"
+
+TEST_CASE( "approximate presortedness measure: rem", "[probe][sampled_rem]" )
+{
+    SECTION( "small collections are measured exactly" )
+    {
+        std::forward_list<int> li = { 6, 9, 79, 41, 44, 49, 11, 16, 69, 15 };
+        CHECK( cppsort::probe::sampled_rem(li) == 4 );
+        CHECK( cppsort::probe::sampled_rem(std::begin(li), std::end(li)) == 4 );
+    }
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    dist::ascending{}(std::back_inserter(collection), 100'000);
+
+    SECTION( "sorted collection" )
+    {
+        CHECK( cppsort::probe::sampled_rem(collection) == 0 );
+    }
+
+    SECTION( "few elements out of place" )
+    {
+        // Rem is at most the number of overwritten elements
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> dist(0, 99'999);
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            collection[dist(engine)] = dist(engine);
+        }
+        auto exact = cppsort::probe::rem(collection);
+        CHECK( std::abs(cppsort::probe::sampled_rem(collection) - exact) <= 5'000 );
+
+        std::forward_list<int> li(std::begin(collection), std::end(collection));
+        CHECK( std::abs(cppsort::probe::sampled_rem(li) - exact) <= 5'000 );
+    }
+
+    SECTION( "degenerate sample sizes" )
+    {
+        // Clamped to the smallest sample that can be scaled
+        CHECK( cppsort::probe::sampled_rem_probe(0)(collection) == 0 );
+        CHECK( cppsort::probe::sampled_rem_probe(-1)(collection) == 0 );
+        std::reverse(std::begin(collection), std::end(collection));
+        auto estimate = cppsort::probe::sampled_rem_probe(0)(collection);
+        CHECK( estimate >= 0 );
+        CHECK( estimate < 100'000 );
+    }
+}
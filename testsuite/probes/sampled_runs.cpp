@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <forward_list>
+#include <iterator>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/probes/sampled_runs.h>
+#include "../distributions.h"
+
+TEST_CASE( "approximate presortedness measure: runs", "[probe][sampled_runs]" )
+{
+    SECTION( "small collections are measured exactly" )
+    {
+        std::vector<int> vec = { 40, 49, 58, 99, 60, 70, 12, 87, 9, 8, 82, 91, 99, 67, 82, 92 };
+        CHECK( cppsort::probe::sampled_runs(vec) == 5 );
+        CHECK( cppsort::probe::sampled_runs(std::begin(vec), std::end(vec)) == 5 );
+    }
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    dist::shuffled{}(std::back_inserter(collection), 100'000, 0);
+
+    SECTION( "bounds" )
+    {
+        std::sort(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_runs(collection) == 0 );
+        std::reverse(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_runs(collection) == 99'999 );
+    }
+
+    SECTION( "estimate" )
+    {
+        std::sort(std::begin(collection), std::begin(collection) + 70'000);
+        auto exact = cppsort::probe::runs(collection);
+        CHECK( std::abs(cppsort::probe::sampled_runs(collection) - exact) <= 5'000 );
+
+        // Forward iterators are measured exactly
+        std::forward_list<int> li(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_runs(li) == exact );
+    }
+
+    SECTION( "degenerate sample sizes" )
+    {
+        // Clamped to the smallest sample that can be scaled
+        std::sort(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_runs_probe(0)(collection) == 0 );
+        std::reverse(std::begin(collection), std::end(collection));
+        CHECK( cppsort::probe::sampled_runs_probe(0)(collection) == 99'999 );
+        CHECK( cppsort::probe::sampled_runs_probe(-1)(collection) == 99'999 );
+    }
+}
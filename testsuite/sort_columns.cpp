@@ -0,0 +1,170 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sort_columns.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include "distributions.h"
+#include "move_only.h"
+
+TEST_CASE( "sort a key column with companion columns", "[sort_columns]" )
+{
+    std::vector<int> keys; keys.reserve(300);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(keys), 300);
+
+    // Every companion column is derived from the keys
+    // and the original position of the elements
+    std::vector<std::string> names;
+    std::vector<double> positions;
+    for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+        names.push_back(std::to_string(keys[i]));
+        positions.push_back(double(i));
+    }
+
+    auto check_columns = [&] {
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        bool columns_match = true;
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            columns_match = columns_match && names[i] == std::to_string(keys[i]);
+        }
+        CHECK( columns_match );
+    };
+
+    SECTION( "comparison sorter" )
+    {
+        cppsort::sort_columns(cppsort::pdq_sorter{}, keys, names, positions);
+        check_columns();
+    }
+
+    SECTION( "radix sorter" )
+    {
+        cppsort::sort_columns(cppsort::ska_sorter{}, keys, names, positions);
+        check_columns();
+    }
+
+    SECTION( "stable sorter" )
+    {
+        cppsort::sort_columns(cppsort::merge_sorter{}, keys, names, positions);
+        check_columns();
+        bool is_stable = true;
+        for (std::size_t i = 1 ; i < keys.size() ; ++i) {
+            if (keys[i - 1] == keys[i]) {
+                is_stable = is_stable && positions[i - 1] < positions[i];
+            }
+        }
+        CHECK( is_stable );
+    }
+
+    SECTION( "string keys and move-only columns" )
+    {
+        std::vector<move_only<int>> values;
+        for (int key: keys) {
+            values.emplace_back(key);
+        }
+
+        cppsort::sort_columns(cppsort::ska_sorter{}, names, values);
+        CHECK( std::is_sorted(std::begin(names), std::end(names)) );
+        bool columns_match = true;
+        for (std::size_t i = 0 ; i < names.size() ; ++i) {
+            columns_match = columns_match && names[i] == std::to_string(values[i].value);
+        }
+        CHECK( columns_match );
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        cppsort::sort_columns(cppsort::pdq_sorter{}, keys, std::greater<>{}, names, positions);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+        bool columns_match = true;
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            columns_match = columns_match && names[i] == std::to_string(keys[i]);
+        }
+        CHECK( columns_match );
+
+        cppsort::sort_columns(cppsort::ska_sorter{}, keys, std::negate<>{}, names, positions);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+
+        cppsort::sort_columns(cppsort::merge_sorter{}, keys, std::greater<>{}, std::negate<>{},
+                              names, positions);
+        check_columns();
+    }
+
+    SECTION( "columns of different sizes" )
+    {
+        auto keys_copy = keys;
+        names.pop_back();
+        CHECK_THROWS_AS( cppsort::sort_columns(cppsort::pdq_sorter{}, keys, names, positions),
+                         std::invalid_argument );
+        CHECK( keys == keys_copy );
+    }
+
+    SECTION( "throwing comparison" )
+    {
+        auto names_copy = names;
+        auto positions_copy = positions;
+        int nb_comparisons = 0;
+        auto throwing_less = [&nb_comparisons](const std::string& lhs, const std::string& rhs) {
+            if (++nb_comparisons == 500) {
+                throw std::runtime_error("comparison failed");
+            }
+            return lhs < rhs;
+        };
+
+        CHECK_THROWS_AS( cppsort::sort_columns(cppsort::pdq_sorter{}, names, throwing_less, positions),
+                         std::runtime_error );
+        CHECK( names == names_copy );
+        CHECK( positions == positions_copy );
+
+        // Move-only keys are moved back to the column
+        std::vector<move_only<int>> values;
+        for (int key: keys) {
+            values.emplace_back(key);
+        }
+        auto throwing_compare = [](const move_only<int>&, const move_only<int>&) -> bool {
+            throw std::runtime_error("comparison failed");
+        };
+        CHECK_THROWS_AS( cppsort::sort_columns(cppsort::pdq_sorter{}, values, throwing_compare, positions),
+                         std::runtime_error );
+        bool values_match = true;
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            values_match = values_match && values[i].value == keys[i];
+        }
+        CHECK( values_match );
+    }
+
+    SECTION( "key column alone" )
+    {
+        cppsort::sort_columns(cppsort::pdq_sorter{}, keys);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sort_indices.h>
+#include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include "distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::string name;
+    };
+}
+
+TEST_CASE( "sort_indices with any sorter", "[sort_indices]" )
+{
+    std::vector<int> collection; collection.reserve(200);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(collection), 200);
+
+    auto check_indices = [&](const std::vector<std::size_t>& indices, auto compare) {
+        CHECK( indices.size() == collection.size() );
+        auto sorted_indices = indices;
+        std::sort(std::begin(sorted_indices), std::end(sorted_indices));
+        std::vector<std::size_t> expected(indices.size());
+        std::iota(std::begin(expected), std::end(expected), 0);
+        CHECK( sorted_indices == expected );
+        std::vector<int> sorted;
+        for (auto index: indices) {
+            sorted.push_back(collection[index]);
+        }
+        CHECK( std::is_sorted(std::begin(sorted), std::end(sorted), compare) );
+    };
+
+    SECTION( "comparison sorter" )
+    {
+        auto indices = cppsort::sort_indices(cppsort::pdq_sorter{}, collection);
+        check_indices(indices, std::less<>{});
+        indices = cppsort::sort_indices(cppsort::pdq_sorter{}, collection, std::greater<>{});
+        check_indices(indices, std::greater<>{});
+    }
+
+    SECTION( "non-comparison sorter" )
+    {
+        auto indices = cppsort::sort_indices(cppsort::spread_sorter{}, collection);
+        check_indices(indices, std::less<>{});
+    }
+
+    SECTION( "stability and projection" )
+    {
+        std::vector<wrapper> wrappers;
+        for (int value: collection) {
+            wrappers.push_back({ value, std::to_string(value) });
+        }
+
+        auto indices = cppsort::sort_indices(cppsort::merge_sorter{}, wrappers, &wrapper::value);
+        for (std::size_t i = 1 ; i < indices.size() ; ++i) {
+            const auto& lhs = wrappers[indices[i - 1]];
+            const auto& rhs = wrappers[indices[i]];
+            CHECK( lhs.value <= rhs.value );
+            if (lhs.value == rhs.value) {
+                CHECK( indices[i - 1] < indices[i] );
+            }
+        }
+    }
+
+    SECTION( "write the indices to a buffer" )
+    {
+        std::vector<std::uint32_t> indices(collection.size() + 1, 0);
+        auto end = cppsort::sort_indices(cppsort::insertion_sorter{},
+                                         std::begin(collection), std::end(collection),
+                                         std::begin(indices), std::greater<>{});
+        CHECK( end == std::end(indices) - 1 );
+        for (auto it = std::begin(indices) + 1 ; it != end ; ++it) {
+            CHECK( collection[*(it - 1)] >= collection[*it] );
+        }
+    }
+}
+
+TEST_CASE( "apply_permutation on several collections", "[sort_indices]" )
+{
+    std::vector<int> keys = { 5, 3, 8, 1, 9, 2, 7, 4, 6, 0 };
+    std::vector<std::string> names;
+    for (int key: keys) {
+        names.push_back(std::to_string(key));
+    }
+
+    std::vector<int> indices(keys.size());
+    cppsort::sort_indices(cppsort::pdq_sorter{}, std::begin(keys), std::end(keys),
+                          std::begin(indices));
+    auto indices_copy = indices;
+
+    cppsort::apply_permutation(indices, keys, names);
+    CHECK( indices == indices_copy );
+    CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+    for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+        CHECK( names[i] == std::to_string(keys[i]) );
+    }
+}
+
+TEST_CASE( "apply_permutation with read-only indices", "[sort_indices]" )
+{
+    std::vector<int> keys = { 5, 3, 8, 1, 9, 2, 7, 4, 6, 0 };
+    const std::vector<std::size_t> indices = cppsort::sort_indices(cppsort::pdq_sorter{}, keys);
+
+    SECTION( "with a buffer" )
+    {
+        cppsort::apply_permutation(indices, keys);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+    }
+
+    SECTION( "following the cycles" )
+    {
+        cppsort::detail::apply_permutation(std::begin(keys), std::end(keys),
+                                           std::begin(indices));
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+    }
+}
+
+TEST_CASE( "apply_permutation with collections of different sizes", "[sort_indices]" )
+{
+    std::vector<int> keys = { 5, 3, 8, 1, 9, 2, 7, 4, 6, 0 };
+    auto indices = cppsort::sort_indices(cppsort::pdq_sorter{}, keys);
+    std::vector<int> shorter(keys.begin(), keys.end() - 1);
+    auto keys_copy = keys;
+
+    CHECK_THROWS_AS( cppsort::apply_permutation(indices, keys, shorter),
+                     std::invalid_argument );
+    CHECK( keys == keys_copy );
+}
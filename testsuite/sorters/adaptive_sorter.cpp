@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/adaptive_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../algorithm.h"
+#include "../distributions.h"
+
+namespace
+{
+    template<typename T>
+    auto check_adaptive_sort(std::vector<T> collection)
+        -> void
+    {
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(cppsort::adaptive_sorter{}, collection);
+        CHECK( collection == expected );
+    }
+}
+
+TEST_CASE( "adaptive_sorter tests", "[adaptive_sorter]" )
+{
+    // Each distribution exercises a different path of the sorter
+
+    std::vector<int> collection;
+    collection.reserve(10'000);
+
+    SECTION( "small collection" )
+    {
+        dist::shuffled{}(std::back_inserter(collection), 100, -50);
+        check_adaptive_sort(collection);
+    }
+
+    SECTION( "sorted collection" )
+    {
+        dist::all_equal{}(std::back_inserter(collection), 10'000);
+        check_adaptive_sort(collection);
+        collection.clear();
+        dist::ascending{}(std::back_inserter(collection), 10'000);
+        check_adaptive_sort(collection);
+    }
+
+    SECTION( "reversed collection" )
+    {
+        dist::descending{}(std::back_inserter(collection), 10'000);
+        check_adaptive_sort(collection);
+    }
+
+    SECTION( "few runs" )
+    {
+        dist::pipe_organ{}(std::back_inserter(collection), 10'000);
+        check_adaptive_sort(collection);
+        collection.clear();
+        dist::descending_sawtooth{}(std::back_inserter(collection), 10'000);
+        check_adaptive_sort(collection);
+    }
+
+    SECTION( "few elements out of place" )
+    {
+        dist::ascending{}(std::back_inserter(collection), 10'000);
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> dist(0, 9'999);
+        for (int i = 0 ; i < 500 ; ++i) {
+            collection[dist(engine)] = dist(engine);
+        }
+        check_adaptive_sort(collection);
+
+        std::vector<std::string> strings;
+        for (int value: collection) {
+            strings.push_back("a rather long prefix " + std::to_string(value));
+        }
+        check_adaptive_sort(strings);
+    }
+
+    SECTION( "shuffled collection" )
+    {
+        dist::shuffled{}(std::back_inserter(collection), 10'000, -5'000);
+        check_adaptive_sort(collection);
+
+        std::vector<std::string> strings;
+        for (int value: collection) {
+            strings.push_back(std::to_string(value));
+        }
+        check_adaptive_sort(strings);
+    }
+}
+
+TEST_CASE( "adaptive_sorter with compare and projection", "[adaptive_sorter]" )
+{
+    struct wrapper { int value; };
+
+    std::vector<wrapper> collection(10'000);
+    helpers::iota(std::begin(collection), std::end(collection), 0, &wrapper::value);
+    std::mt19937 engine(Catch::rngSeed());
+
+    SECTION( "shuffled" )
+    {
+        std::shuffle(std::begin(collection), std::end(collection), engine);
+        cppsort::sort(cppsort::adaptive_sorter{}, collection, std::greater<>{}, &wrapper::value);
+        CHECK( helpers::is_sorted(std::begin(collection), std::end(collection),
+                                  std::greater<>{}, &wrapper::value) );
+    }
+
+    SECTION( "few elements out of place" )
+    {
+        std::shuffle(std::begin(collection), std::begin(collection) + 300, engine);
+        cppsort::sort(cppsort::adaptive_sorter{}, collection, &wrapper::value);
+        CHECK( helpers::is_sorted(std::begin(collection), std::end(collection),
+                                  std::less<>{}, &wrapper::value) );
+    }
+}
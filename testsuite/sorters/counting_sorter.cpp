@@ -23,12 +23,17 @@
  */
 #include <algorithm>
 #include <forward_list>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
+#include <string>
+#include <utility>
 #include <vector>
 #include <catch.hpp>
 #include <cpp-sort/sorters/counting_sorter.h>
 #include <cpp-sort/sort.h>
+#include "../algorithm.h"
 #include "../distributions.h"
 
 TEST_CASE( "counting_sorter tests", "[counting_sorter]" )
@@ -82,3 +87,115 @@ TEST_CASE( "counting_sorter tests", "[counting_sorter]" )
         CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
     }
 }
+
+TEST_CASE( "counting_sorter tests with projections",
+           "[counting_sorter][projection]" )
+{
+    // Records with a small integer key, the position of every
+    // record in the original collection is kept to check that
+    // the sort is stable
+    using record = std::pair<short, int>;
+    auto size = 10'000;
+
+    std::vector<record> vec; vec.reserve(size);
+    std::vector<int> keys; keys.reserve(size);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(keys), size);
+    for (int i = 0 ; i < size ; ++i) {
+        vec.emplace_back(short(keys[i] - 8), i);
+    }
+
+    SECTION( "stable sort with a projection" )
+    {
+        cppsort::sort(cppsort::counting_sorter{}, vec, &record::first);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "stable reverse sort with a projection" )
+    {
+        cppsort::sort(cppsort::counting_sorter{}, vec, std::greater<>{}, &record::first);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const auto& lhs, const auto& rhs) {
+            if (lhs.first != rhs.first) {
+                return lhs.first > rhs.first;
+            }
+            return lhs.second < rhs.second;
+        }) );
+    }
+
+    SECTION( "stable sort of a forward_list of strings" )
+    {
+        std::forward_list<std::pair<int, std::string>> li;
+        for (auto it = vec.rbegin() ; it != vec.rend() ; ++it) {
+            li.emplace_front(it->first, std::to_string(it->second));
+        }
+        cppsort::sort(cppsort::counting_sorter{}, li, &std::pair<int, std::string>::first);
+        CHECK( helpers::is_sorted(std::begin(li), std::end(li),
+                                  std::less<>{}, &std::pair<int, std::string>::first) );
+
+        // Elements with equal keys keep their relative order
+        auto it = std::begin(li);
+        bool is_stable = true;
+        for (auto next = std::next(it) ; next != std::end(li) ; ++it, ++next) {
+            if (it->first == next->first) {
+                is_stable = is_stable && std::stoi(it->second) < std::stoi(next->second);
+            }
+        }
+        CHECK( is_stable );
+    }
+}
+
+TEST_CASE( "counting_sorter tests with sparse ranges",
+           "[counting_sorter]" )
+{
+    // A few values far away from the others are enough to make
+    // the counts too big, the sorter falls back to a radix sort
+    auto size = 10'000;
+
+    std::vector<long long> vec; vec.reserve(size);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(vec), size, -1568);
+    vec[size / 3] = std::numeric_limits<long long>::max();
+    vec[size / 2] = std::numeric_limits<long long>::min();
+
+    SECTION( "sort with random-access iterators" )
+    {
+        cppsort::sort(cppsort::counting_sorter{}, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "reverse sort with random-access iterators" )
+    {
+        cppsort::sort(cppsort::counting_sorter{}, vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "sort with forward iterators" )
+    {
+        std::forward_list<long long> li(std::begin(vec), std::end(vec));
+        cppsort::sort(cppsort::counting_sorter{}, li);
+        CHECK( std::is_sorted(std::begin(li), std::end(li)) );
+
+        cppsort::sort(cppsort::counting_sorter{}, li, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(li), std::end(li), std::greater<>{}) );
+    }
+
+    SECTION( "stable sort with a projection" )
+    {
+        using record = std::pair<int, int>;
+        std::vector<record> records; records.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            records.emplace_back(i % 8 == 0 ? i * 100'000 : i % 16, i);
+        }
+
+        cppsort::sort(cppsort::counting_sorter{}, records, &record::first);
+        CHECK( std::is_sorted(std::begin(records), std::end(records)) );
+
+        cppsort::sort(cppsort::counting_sorter{}, records, std::greater<>{}, &record::first);
+        CHECK( std::is_sorted(std::begin(records), std::end(records), [](const auto& lhs, const auto& rhs) {
+            if (lhs.first != rhs.first) {
+                return lhs.first > rhs.first;
+            }
+            return lhs.second < rhs.second;
+        }) );
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/drop_merge_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "drop_merge_sorter with non-trivially copyable types",
+           "[drop_merge_sorter]" )
+{
+    // The move-only version of the algorithm used to move elements
+    // onto themselves, which empties some std::string implementations
+
+    std::vector<int> vec; vec.reserve(1000);
+    dist::pipe_organ{}(std::back_inserter(vec), 1000);
+
+    std::vector<std::string> collection;
+    for (int value: vec) {
+        collection.push_back(std::to_string(value));
+    }
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    cppsort::sort(cppsort::drop_merge_sorter{}, collection);
+    CHECK( collection == expected );
+}
@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/parallel_counting_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_counting_sorter tests", "[parallel_counting_sorter]" )
+{
+    // Big enough to go through the parallel code paths
+    auto size = 500'000;
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec; vec.reserve(size);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(vec), size);
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "reverse sort with unsigned iterators" )
+    {
+        std::vector<unsigned> vec; vec.reserve(size);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(vec), size);
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+
+        cppsort::sort(cppsort::parallel_counting_sort, std::begin(vec), std::end(vec),
+                      std::greater<>{});
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with a wide range of values" )
+    {
+        // More values than elements per thread: counted serially
+        std::vector<long long> vec; vec.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), size, -250'000LL);
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with extreme values" )
+    {
+        // max - min overflows int, and the range is too sparse
+        // for the histograms
+        std::vector<int> vec; vec.reserve(100'000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000, -50'000);
+        vec[10] = std::numeric_limits<int>::min();
+        vec[20] = std::numeric_limits<int>::max();
+        auto copy = vec;
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+
+        std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+        cppsort::sort(cppsort::parallel_counting_sort, copy, std::greater<>{});
+        CHECK( copy == expected );
+
+        // Values around -2e9 and 2e9
+        for (auto& value: vec) {
+            value = value < 0 ? -2'000'000'000 + value % 1000 : 2'000'000'000 - value % 1000;
+        }
+        expected = vec;
+        std::sort(std::begin(expected), std::end(expected));
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with almost sorted data" )
+    {
+        std::vector<short> vec; vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(short(i / 1000));
+        }
+        auto expected = vec;
+
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+
+        std::swap(vec.front(), vec.back());
+        cppsort::sort(cppsort::parallel_counting_sort, vec);
+        CHECK( vec == expected );
+
+        std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+        cppsort::sort(cppsort::parallel_counting_sort, vec, std::greater<>{});
+        CHECK( vec == expected );
+    }
+}
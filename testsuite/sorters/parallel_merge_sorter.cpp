@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_merge_sorter tests", "[parallel_merge_sorter]" )
+{
+    // Big enough to go through the parallel code paths
+    std::vector<long long int> vec; vec.reserve(500'000);
+
+    SECTION( "sort with shuffled iterable" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 500'000, -125'000);
+        cppsort::sort(cppsort::parallel_merge_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with shuffled iterators and compare" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 500'000, -125'000);
+        cppsort::sort(cppsort::parallel_merge_sort, std::begin(vec), std::end(vec), std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "sort with patterns" )
+    {
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(vec), 500'000);
+        cppsort::sort(cppsort::parallel_merge_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+
+        std::reverse(std::begin(vec), std::end(vec));
+        cppsort::sort(cppsort::parallel_merge_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "exception thrown by a comparison" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 500'000);
+        auto throwing_compare = [](long long int lhs, long long int rhs) {
+            if (lhs == 1000 || rhs == 1000) {
+                throw std::runtime_error("comparison failed");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS( cppsort::parallel_merge_sort(vec, throwing_compare), std::runtime_error );
+    }
+}
+
+TEST_CASE( "parallel_merge_sorter stability",
+           "[parallel_merge_sorter][projection][is_stable]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    // Few distinct keys so that there are many equivalent elements
+    // on both sides of every merge
+    std::vector<std::pair<int, int>> vec;
+    for (int i = 0 ; i < 300'000 ; ++i) {
+        vec.emplace_back(i % 37, 0);
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+    for (int i = 0 ; i < 300'000 ; ++i) {
+        vec[i].second = i;
+    }
+
+    cppsort::sort(cppsort::parallel_merge_sort, vec, &std::pair<int, int>::first);
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+}
@@ -0,0 +1,123 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_ska_sorter tests", "[parallel_ska_sorter]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    // Big enough to go through the parallel code paths
+    constexpr int size = 500'000;
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), size, -125'000);
+        cppsort::sort(cppsort::parallel_ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with 64-bit keys sharing the top bytes" )
+    {
+        // Every element falls in the same bucket for the first bytes
+        std::vector<std::uint64_t> vec(size);
+        std::iota(std::begin(vec), std::end(vec), 0);
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::parallel_ska_sort, std::begin(vec), std::end(vec));
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with few distinct values" )
+    {
+        std::vector<long long int> vec;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(vec), size);
+        cppsort::sort(cppsort::parallel_ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with double iterable" )
+    {
+        std::vector<double> vec(size);
+        std::iota(std::begin(vec), std::end(vec), -250'000.0);
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::parallel_ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with std::pair" )
+    {
+        // The second element is sorted by the serial algorithm
+        std::vector<std::pair<int, std::string>> vec;
+        for (int i = 0 ; i < size ; ++i) {
+            vec.emplace_back(i % 1000, std::to_string(i));
+        }
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::parallel_ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        // Not parallelized, falls back to ska_sort
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::parallel_ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+}
+
+TEST_CASE( "parallel_ska_sorter tests with projections",
+           "[parallel_ska_sorter][projection]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    std::vector<std::pair<int, unsigned>> vec;
+    for (int i = 0 ; i < 200'000 ; ++i) {
+        vec.emplace_back(i, 200'000u - i);
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    cppsort::sort(cppsort::parallel_ska_sort, vec, &std::pair<int, unsigned>::second);
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](auto&& lhs, auto&& rhs) {
+        return lhs.first > rhs.first;
+    }) );
+}
@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/parallel_string_spread_sorter.h>
+#include <cpp-sort/sort.h>
+
+TEST_CASE( "parallel_string_spread_sorter tests", "[parallel_string_spread_sorter]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    // Big enough to go through the parallel code paths
+    constexpr int size = 300'000;
+
+    std::vector<std::string> vec;
+    for (int i = 0 ; i < size ; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+    // A few empty strings and duplicates
+    for (int i = 0 ; i < 1000 ; ++i) {
+        vec.emplace_back();
+        vec.push_back(std::to_string(i));
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    SECTION( "sort with std::string" )
+    {
+        cppsort::sort(cppsort::parallel_string_spread_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "reverse sort with std::string" )
+    {
+        cppsort::sort(cppsort::parallel_string_spread_sort, vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "sort strings sharing a long prefix" )
+    {
+        // Every string falls in the same bucket for the first
+        // characters, like timestamps in log files
+        for (auto& str: vec) {
+            str.insert(0, "2017-10-18T");
+        }
+        cppsort::sort(cppsort::parallel_string_spread_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+
+        cppsort::sort(cppsort::parallel_string_spread_sort, vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "parallel_string_spread_sorter tests with projections",
+           "[parallel_string_spread_sorter][projection]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    std::vector<std::pair<int, std::string>> vec;
+    for (int i = 0 ; i < 200'000 ; ++i) {
+        vec.emplace_back(i, std::to_string(i));
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    cppsort::sort(cppsort::parallel_string_spread_sort, vec, &std::pair<int, std::string>::second);
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](auto&& lhs, auto&& rhs) {
+        return lhs.second < rhs.second;
+    }) );
+}
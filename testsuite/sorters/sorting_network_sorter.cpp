@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <catch.hpp>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <cpp-sort/sort.h>
+
+namespace
+{
+    template<typename T, std::size_t N, typename Compare>
+    auto check_sorting_network(std::mt19937& engine, Compare compare)
+        -> bool
+    {
+        std::array<T, N> collection;
+        std::iota(std::begin(collection), std::end(collection), T(-10));
+        std::shuffle(std::begin(collection), std::end(collection), engine);
+        cppsort::sort(cppsort::sorting_network_sorter<N>{}, collection, compare);
+        return std::is_sorted(std::begin(collection), std::end(collection), compare);
+    }
+
+    template<typename T, typename Compare, std::size_t... Indices>
+    auto check_sorting_networks(std::mt19937& engine, Compare compare,
+                                std::index_sequence<Indices...>)
+        -> bool
+    {
+        bool res[] = { check_sorting_network<T, Indices>(engine, compare)... };
+        return std::all_of(std::begin(res), std::end(res), [](bool value) { return value; });
+    }
+}
+
+TEST_CASE( "sorting_network_sorter with arithmetic types",
+           "[sorting_network_sorter]" )
+{
+    // The collections of 32-bit arithmetic types are sorted
+    // with SIMD kernels when they are enabled, make sure that
+    // every size and comparison gives the same results
+
+    std::mt19937 engine(Catch::rngSeed());
+    using sizes = std::make_index_sequence<33>;
+
+    CHECK( check_sorting_networks<std::int32_t>(engine, std::less<>{}, sizes{}) );
+    CHECK( check_sorting_networks<std::int32_t>(engine, std::greater<>{}, sizes{}) );
+    CHECK( check_sorting_networks<std::uint32_t>(engine, std::less<std::uint32_t>{}, sizes{}) );
+    CHECK( check_sorting_networks<float>(engine, std::less<>{}, sizes{}) );
+    CHECK( check_sorting_networks<float>(engine, std::greater<float>{}, sizes{}) );
+    CHECK( check_sorting_networks<long long int>(engine, std::less<>{}, sizes{}) );
+
+    SECTION( "duplicate values" )
+    {
+        std::array<float, 20> collection = {{
+            0.0f, 5.0f, 3.0f, -1.0f, 0.0f, 2.0f, 5.0f, 3.0f, 1.0f, 0.0f,
+            -2.0f, 0.0f, 3.0f, 5.0f, 1.0f, 1.0f, -1.0f, 0.0f, 2.0f, 5.0f
+        }};
+        auto copy = collection;
+
+        cppsort::sort(cppsort::sorting_network_sorter<20>{}, collection);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( collection == copy );
+    }
+}
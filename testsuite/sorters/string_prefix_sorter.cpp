@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/sorters/string_prefix_sorter.h>
+#include <cpp-sort/sort.h>
+
+TEST_CASE( "string_prefix_sorter tests", "[string_prefix_sorter]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    std::vector<std::string> vec;
+    for (int i = 0 ; i < 50'000 ; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+    // Strings that only differ after the cached prefix or by
+    // their trailing null characters
+    for (int i = 0 ; i < 1000 ; ++i) {
+        vec.push_back("common-prefix-" + std::to_string(i));
+        vec.push_back(std::string(i % 12, '\0'));
+        vec.push_back(std::string("ab\0", 3 + i % 8));
+        vec.emplace_back();
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    SECTION( "sort with std::string" )
+    {
+        cppsort::sort(cppsort::string_prefix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "reverse sort with std::string" )
+    {
+        cppsort::sort(cppsort::string_prefix_sort, vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "sort with characters above 127" )
+    {
+        // Characters are compared as unsigned char, like std::string
+        for (auto& str: vec) {
+            if (not str.empty()) {
+                str[0] = static_cast<char>(str[0] + 100);
+            }
+        }
+        cppsort::sort(cppsort::string_prefix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort small collections" )
+    {
+        vec.resize(100);
+        cppsort::sort(cppsort::string_prefix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+}
+
+TEST_CASE( "string_prefix_sorter tests with projections",
+           "[string_prefix_sorter][projection]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    std::vector<std::pair<int, std::string>> vec;
+    for (int i = 0 ; i < 20'000 ; ++i) {
+        vec.emplace_back(i, "some-long-key-" + std::to_string(i));
+    }
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    cppsort::sort(cppsort::string_prefix_sort, vec, &std::pair<int, std::string>::second);
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](auto&& lhs, auto&& rhs) {
+        return lhs.second < rhs.second;
+    }) );
+
+    cppsort::sort(cppsort::string_prefix_sort, vec, std::greater<>{}, &std::pair<int, std::string>::second);
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](auto&& lhs, auto&& rhs) {
+        return lhs.second > rhs.second;
+    }) );
+}
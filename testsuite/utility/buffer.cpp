@@ -21,9 +21,14 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
+#include <iterator>
+#include <vector>
 #include <catch.hpp>
+#include <cpp-sort/sorters/grail_sorter.h>
 #include <cpp-sort/utility/buffer.h>
 #include <cpp-sort/utility/functional.h>
+#include "../distributions.h"
 
 TEST_CASE( "miscellaneous tests for buffer providers",
            "[utility][buffer]" )
@@ -60,4 +65,67 @@ TEST_CASE( "miscellaneous tests for buffer providers",
         CHECK( buffer.end() == buffer.cend() );
         CHECK( buffer.end() == buffer.begin() + buffer.size() );
     }
+
+    SECTION( "cached_buffer" )
+    {
+        utility::cached_buffer<utility::sqrt>::buffer<int> buffer(25);
+
+        CHECK( buffer.size() == 5 );
+        CHECK( buffer.begin() == buffer.cbegin() );
+        CHECK( buffer.end() == buffer.cend() );
+        CHECK( buffer.end() == buffer.begin() + buffer.size() );
+    }
+
+    SECTION( "cached_buffer of size 0" )
+    {
+        utility::cached_buffer<utility::identity>::buffer<int> buffer(0);
+
+        CHECK( buffer.size() == 0 );
+        CHECK( buffer.begin() == buffer.end() );
+    }
+}
+
+TEST_CASE( "cached_buffer reuses memory across sorts",
+           "[utility][buffer][grail_sorter]" )
+{
+    using namespace cppsort;
+    using provider = utility::cached_buffer<utility::identity>;
+    provider::clear_cache<long>();
+
+    SECTION( "buffers of the same size class are reused" )
+    {
+        long* memory = nullptr;
+        {
+            provider::buffer<long> buffer(100);
+            memory = buffer.begin();
+        }
+        {
+            provider::buffer<long> buffer(120);
+            CHECK( buffer.size() == 120 );
+            CHECK( buffer.begin() == memory );
+        }
+        {
+            // Two live buffers can't share the same memory
+            provider::buffer<long> buffer1(100);
+            provider::buffer<long> buffer2(100);
+            CHECK( buffer1.begin() == memory );
+            CHECK( buffer2.begin() != memory );
+        }
+    }
+
+    SECTION( "sorting with a cached buffer" )
+    {
+        std::vector<long> collection; collection.reserve(1000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 1000, -300);
+
+        grail_sorter<provider> sorter;
+        for (int i = 0 ; i < 3 ; ++i) {
+            std::vector<long> copy = collection;
+            sorter(copy);
+            CHECK( std::is_sorted(std::begin(copy), std::end(copy)) );
+        }
+    }
+
+    provider::clear_cache<long>();
 }
@@ -0,0 +1,170 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/adapters/verge_adapter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorters.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Memory resource that keeps track of the memory
+    // it allocated and that forwards to operator new
+    class tracking_resource:
+        public cppsort::utility::memory_resource
+    {
+        public:
+
+            std::size_t nb_allocations = 0;
+            std::size_t allocated = 0;
+
+        private:
+
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                ++nb_allocations;
+                allocated += bytes;
+                return cppsort::utility::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                -> void override
+            {
+                allocated -= bytes;
+                cppsort::utility::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            }
+
+            auto do_is_equal(const memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+    };
+}
+
+TEST_CASE( "buffered sorters with a memory resource",
+           "[utility][memory_resource]" )
+{
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000, -500);
+
+    tracking_resource resource;
+
+    SECTION( "merge_sorter" )
+    {
+        cppsort::sort(cppsort::merge_sorter(&resource), collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+
+        std::list<int> li;
+        distribution(std::back_inserter(li), 1000, -500);
+        cppsort::sort(cppsort::merge_sorter(&resource), li);
+        CHECK( std::is_sorted(std::begin(li), std::end(li)) );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "tim_sorter" )
+    {
+        cppsort::sort(cppsort::tim_sorter(&resource), collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "merge_insertion_sorter" )
+    {
+        cppsort::sort(cppsort::merge_insertion_sorter(&resource), collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "drop_merge_sorter" )
+    {
+        cppsort::sort(cppsort::drop_merge_sorter(&resource), collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "verge_sorter" )
+    {
+        std::vector<int> vec; vec.reserve(1000);
+        dist::descending_sawtooth{}(std::back_inserter(vec), 1000);
+        cppsort::sort(cppsort::verge_sorter(&resource), vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "stable_adapter" )
+    {
+        // The resource is used by the adapter itself
+        using sorter1 = cppsort::stable_adapter<cppsort::pdq_sorter>;
+        cppsort::sort(sorter1(&resource), collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+
+        // The resource is forwarded to the adapted sorter
+        using sorter2 = cppsort::stable_adapter<cppsort::merge_sorter>;
+        resource.nb_allocations = 0;
+        std::shuffle(std::begin(collection), std::end(collection), std::mt19937{});
+        cppsort::sort(sorter2(&resource), collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "schwartz_adapter" )
+    {
+        using sorter = cppsort::schwartz_adapter<cppsort::tim_sorter>;
+        cppsort::sort(sorter(&resource), collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "verge_adapter" )
+    {
+        using sorter = cppsort::verge_adapter<cppsort::merge_sorter>;
+        cppsort::sort(sorter(&resource), collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( resource.nb_allocations > 0 );
+        CHECK( resource.allocated == 0 );
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <catch.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/merge_insertion_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include <cpp-sort/utility/sort_workspace.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Upstream resource counting the allocations
+    class counting_resource:
+        public cppsort::utility::memory_resource
+    {
+        public:
+
+            std::size_t nb_allocations = 0;
+            std::size_t nb_deallocations = 0;
+
+        private:
+
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                ++nb_allocations;
+                return cppsort::utility::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                -> void override
+            {
+                ++nb_deallocations;
+                cppsort::utility::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            }
+
+            auto do_is_equal(const memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+    };
+
+    template<typename Sorter>
+    auto check_reuse(const Sorter& sorter, counting_resource& upstream)
+        -> void
+    {
+        std::vector<int> collection; collection.reserve(1000);
+        auto distribution = dist::shuffled{};
+
+        // Warm up the workspace
+        distribution(std::back_inserter(collection), 1000, -500);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        for (int i = 0 ; i < 2 ; ++i) {
+            distribution(std::begin(collection), 1000, -500);
+            cppsort::sort(sorter, collection);
+            CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        }
+
+        // Sorts of the same size shouldn't allocate anymore
+        auto nb_allocations = upstream.nb_allocations;
+        for (int i = 0 ; i < 5 ; ++i) {
+            distribution(std::begin(collection), 1000, -500);
+            cppsort::sort(sorter, collection);
+            CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        }
+        CHECK( upstream.nb_allocations == nb_allocations );
+
+        // Neither should smaller sorts
+        collection.resize(500);
+        distribution(std::begin(collection), 500, -250);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( upstream.nb_allocations == nb_allocations );
+    }
+}
+
+TEST_CASE( "reuse memory with sort_workspace",
+           "[utility][sort_workspace]" )
+{
+    counting_resource upstream;
+
+    SECTION( "merge_sorter" )
+    {
+        cppsort::utility::sort_workspace workspace(&upstream);
+        check_reuse(cppsort::merge_sorter(&workspace), upstream);
+        CHECK( workspace.capacity() > 0 );
+    }
+
+    SECTION( "tim_sorter" )
+    {
+        cppsort::utility::sort_workspace workspace(&upstream);
+        check_reuse(cppsort::tim_sorter(&workspace), upstream);
+        CHECK( workspace.capacity() > 0 );
+    }
+
+    SECTION( "merge_insertion_sorter" )
+    {
+        cppsort::utility::sort_workspace workspace(&upstream);
+        check_reuse(cppsort::merge_insertion_sorter(&workspace), upstream);
+        CHECK( workspace.capacity() > 0 );
+    }
+
+    SECTION( "stable_adapter" )
+    {
+        using sorter = cppsort::stable_adapter<cppsort::pdq_sorter>;
+        cppsort::utility::sort_workspace workspace(&upstream);
+        check_reuse(sorter(&workspace), upstream);
+        CHECK( workspace.capacity() > 0 );
+    }
+
+    SECTION( "reserve and release" )
+    {
+        cppsort::utility::sort_workspace workspace(4096, &upstream);
+        CHECK( workspace.capacity() == 4096 );
+        CHECK( upstream.nb_allocations == 1 );
+
+        workspace.release();
+        CHECK( workspace.capacity() == 0 );
+        CHECK( upstream.nb_deallocations == 1 );
+    }
+
+    CHECK( upstream.nb_allocations == upstream.nb_deallocations );
+}